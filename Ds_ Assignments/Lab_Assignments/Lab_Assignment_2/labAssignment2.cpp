@@ -1,4 +1,11 @@
 #include <bits/stdc++.h>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#define fsync _commit
+#else
+#include <unistd.h>
+#endif
 using namespace std;
 
 // Simple Customer Support Ticket System
@@ -89,12 +96,39 @@ public:
     }
 };
 
-// --- Stack for Undo Operation ---
+// --- String Pool ---
+// Names and issues repeat a lot, so every string is stored once
+// and actions / journal records only keep its small integer id.
+class StringPool {
+    unordered_map<string, uint32_t> ids;
+    vector<string> strs;
+public:
+    // returns the id of s, isNew tells if it was seen for the first time
+    uint32_t intern(const string &s, bool &isNew) {
+        auto it = ids.find(s);
+        if (it != ids.end()) {
+            isNew = false;
+            return it->second;
+        }
+        uint32_t id = strs.size();
+        ids[s] = id;
+        strs.push_back(s);
+        isNew = true;
+        return id;
+    }
+    const string& get(uint32_t id) { return strs[id]; }
+    int size() { return strs.size(); }
+};
+
+// --- Stack for Undo / Redo Operation ---
+// One byte opcode + ids only, no string copies.
+enum OpCode : uint8_t { OP_STR = 1, OP_ADD = 2, OP_DONE = 3, OP_UNDO = 4, OP_REDO = 5 };
+
 struct Action {
-    string type;
-    int id;
-    string name;
-    string issue;
+    uint8_t op;
+    uint32_t id;
+    uint32_t name;   // id in StringPool
+    uint32_t issue;  // id in StringPool
     int priority;
 };
 
@@ -105,6 +139,159 @@ public:
     bool empty() { return st.empty(); }
     Action top() { return st.back(); }
     void pop() { st.pop_back(); }
+    void clear() { st.clear(); }
+};
+
+// --- Append-only Journal ---
+// Record layout (ints are LEB128 varints, priority is zigzag encoded):
+//   OP_STR  len bytes          -> next string id (ids are implicit, in order)
+//   OP_ADD  id name issue prio
+//   OP_DONE id
+//   OP_UNDO / OP_REDO          -> no payload, replay uses its own stacks
+// Records are buffered and fsync'd once per group of `groupSize` records.
+class Journal {
+    FILE* fp;
+    vector<uint8_t> buf;
+    int pending;
+    int groupSize;
+public:
+    long long bytesWritten;
+    long long records;
+    long long syncs;
+
+    Journal() {
+        fp = NULL;
+        pending = 0;
+        groupSize = 64;
+        bytesWritten = records = syncs = 0;
+    }
+    ~Journal() { close(); }
+
+    bool open(string path, int group) {
+        close();
+        fp = fopen(path.c_str(), "ab");
+        groupSize = max(1, group);
+        return fp != NULL;
+    }
+
+    bool isOpen() { return fp != NULL; }
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) {
+            buf.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        buf.push_back((uint8_t)v);
+    }
+
+    void logString(const string &s) {
+        buf.push_back(OP_STR);
+        putVarint(s.size());
+        buf.insert(buf.end(), s.begin(), s.end());
+        endRecord();
+    }
+
+    void logAdd(uint32_t id, uint32_t name, uint32_t issue, int pr) {
+        buf.push_back(OP_ADD);
+        putVarint(id);
+        putVarint(name);
+        putVarint(issue);
+        putVarint(((uint32_t)pr << 1) ^ (uint32_t)(pr >> 31));
+        endRecord();
+    }
+
+    void logDone(uint32_t id) {
+        buf.push_back(OP_DONE);
+        putVarint(id);
+        endRecord();
+    }
+
+    void logOp(uint8_t op) {
+        buf.push_back(op);
+        endRecord();
+    }
+
+    void endRecord() {
+        records++;
+        pending++;
+        if (pending >= groupSize) sync();
+    }
+
+    // group commit: one write + one fsync for the whole batch
+    void sync() {
+        if (fp == NULL || buf.empty()) return;
+        fwrite(buf.data(), 1, buf.size(), fp);
+        fflush(fp);
+        fsync(fileno(fp));
+        bytesWritten += buf.size();
+        buf.clear();
+        pending = 0;
+        syncs++;
+    }
+
+    void close() {
+        if (fp == NULL) return;
+        sync();
+        fclose(fp);
+        fp = NULL;
+    }
+};
+
+// cut a file back to `size` bytes, used to drop a torn journal tail
+bool truncateFile(const string &path, long long size) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _chsize_s(fd, size) == 0;
+    _close(fd);
+    return ok;
+#else
+    return truncate(path.c_str(), size) == 0;
+#endif
+}
+
+// Reader for the journal, stops cleanly at a torn (half written) record
+class JournalReader {
+    vector<uint8_t> data;
+    size_t pos;
+public:
+    JournalReader() { pos = 0; }
+
+    bool load(string path) {
+        ifstream in(path, ios::binary);
+        if (!in) return false;
+        data.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        pos = 0;
+        return true;
+    }
+
+    size_t size() { return data.size(); }
+    size_t position() { return pos; }
+    bool atEnd() { return pos >= data.size(); }
+
+    bool getByte(uint8_t &b) {
+        if (pos >= data.size()) return false;
+        b = data[pos++];
+        return true;
+    }
+
+    bool getVarint(uint64_t &v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b;
+            if (!getByte(b)) return false;
+            v |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool getString(string &s, uint64_t len) {
+        if (len > data.size() - pos) return false;
+        s.assign((const char*)data.data() + pos, len);
+        pos += len;
+        return true;
+    }
 };
 
 // --- Priority Queue ---
@@ -119,6 +306,192 @@ struct Compare {
     }
 };
 
+// --- Deficit Round Robin (weighted fair queue) ---
+// One FIFO per priority class. Each time a class gets its turn its
+// deficit grows by quantum * weight, and it may serve items while their
+// cost fits in the deficit. Only non-empty classes sit in the active
+// ring, so picking the next item is O(1) (amortized when costs exceed
+// one turn's credit).
+class DrrScheduler {
+    struct Entry { int item; double cost; };
+    vector<deque<Entry>> queues;
+    vector<double> weight, deficit;
+    vector<char> inTurn;
+    deque<int> active;
+    double quantum;
+    int count;
+public:
+    DrrScheduler(int classes = 5, double q = 1.0) {
+        queues.assign(classes + 1, deque<Entry>());
+        weight.assign(classes + 1, 1.0);
+        deficit.assign(classes + 1, 0.0);
+        inTurn.assign(classes + 1, 0);
+        quantum = q;
+        count = 0;
+        // default: each more urgent class gets twice the share
+        for (int c = 1; c <= classes; c++) weight[c] = ldexp(1.0, classes - c);
+    }
+
+    int classes() { return queues.size() - 1; }
+    bool empty() { return count == 0; }
+    int size() { return count; }
+
+    void setWeights(const vector<double> &w) {
+        for (int c = 1; c <= classes() && c - 1 < (int)w.size(); c++) weight[c] = max(w[c - 1], 1e-9);
+    }
+
+    // priorities outside 1..classes are clamped to the nearest class
+    int classOf(int priority) { return min(max(priority, 1), classes()); }
+
+    void push(int item, int priority, double cost = 1.0) {
+        int c = classOf(priority);
+        if (queues[c].empty()) active.push_back(c);
+        queues[c].push_back({item, cost});
+        count++;
+    }
+
+    bool pop(int &item) {
+        int c;
+        return pop(item, c);
+    }
+
+    // also reports the class the item was served from
+    bool pop(int &item, int &c) {
+        while (!active.empty()) {
+            c = active.front();
+            if (!inTurn[c]) {
+                deficit[c] += quantum * weight[c];
+                inTurn[c] = 1;
+            }
+            Entry &e = queues[c].front();
+            if (e.cost <= deficit[c]) {
+                deficit[c] -= e.cost;
+                item = e.item;
+                queues[c].pop_front();
+                count--;
+                if (queues[c].empty()) {
+                    deficit[c] = 0;
+                    inTurn[c] = 0;
+                    active.pop_front();
+                }
+                return true;
+            }
+            // turn is over, keep the leftover deficit for next round
+            inTurn[c] = 0;
+            active.pop_front();
+            active.push_back(c);
+        }
+        return false;
+    }
+};
+
+// scheduling policies that can be picked at runtime
+enum SchedPolicy { POLICY_PRIORITY, POLICY_ROUND_ROBIN, POLICY_DRR };
+
+string policyName(SchedPolicy p) {
+    if (p == POLICY_PRIORITY) return "priority";
+    if (p == POLICY_ROUND_ROBIN) return "round-robin";
+    return "drr";
+}
+
+bool parsePolicy(string s, SchedPolicy &p) {
+    if (s == "priority") p = POLICY_PRIORITY;
+    else if (s == "rr" || s == "round-robin") p = POLICY_ROUND_ROBIN;
+    else if (s == "drr" || s == "fair") p = POLICY_DRR;
+    else return false;
+    return true;
+}
+
+// --- Bucket Priority Queue ---
+// Priorities are small integers, so instead of a binary heap keep one FIFO
+// bucket per priority and a 64-bit bitmap of non-empty buckets. The most
+// urgent bucket is the lowest set bit (count trailing zeros), so push and
+// pop are O(1) and equal priorities come out in arrival order.
+// Priorities outside 0..63 go to an overflow heap instead, ordered by
+// priority and then by arrival, so they keep their exact order.
+template <class T>
+class BucketQueue {
+    static const int BUCKETS = 64;
+    struct Bucket {
+        vector<T> items;
+        size_t head = 0;
+    };
+    struct Spilled {
+        int priority;
+        uint64_t seq;
+        T item;
+    };
+    struct SpilledLater {
+        bool operator()(const Spilled &a, const Spilled &b) const {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            return a.seq > b.seq;
+        }
+    };
+    Bucket buckets[BUCKETS];
+    uint64_t bitmap;
+    size_t count;
+    priority_queue<Spilled, vector<Spilled>, SpilledLater> overflow;
+    uint64_t nextSeq;
+
+    // negative priorities beat every bucket, priorities past 63 lose to them
+    bool fromOverflow() const {
+        return !overflow.empty() && (bitmap == 0 || overflow.top().priority < 0);
+    }
+
+public:
+    BucketQueue() {
+        bitmap = 0;
+        count = 0;
+        nextSeq = 0;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void push(int priority, const T &item) {
+        if (priority < 0 || priority >= BUCKETS) {
+            overflow.push({priority, nextSeq++, item});
+            count++;
+            return;
+        }
+        int b = priority;
+        buckets[b].items.push_back(item);
+        bitmap |= (uint64_t)1 << b;
+        count++;
+    }
+
+    int topPriority() const {
+        return fromOverflow() ? overflow.top().priority : __builtin_ctzll(bitmap);
+    }
+
+    const T& top() const {
+        if (fromOverflow()) return overflow.top().item;
+        const Bucket &bk = buckets[__builtin_ctzll(bitmap)];
+        return bk.items[bk.head];
+    }
+
+    void pop() {
+        if (fromOverflow()) {
+            overflow.pop();
+            count--;
+            return;
+        }
+        int b = __builtin_ctzll(bitmap);
+        Bucket &bk = buckets[b];
+        bk.head++;
+        count--;
+        if (bk.head == bk.items.size()) {
+            bk.items.clear();  // keeps capacity for the next burst
+            bk.head = 0;
+            bitmap &= ~((uint64_t)1 << b);
+        } else if (bk.head >= 1024 && bk.head * 2 >= bk.items.size()) {
+            // drop the consumed prefix so a never-empty bucket cannot grow forever
+            bk.items.erase(bk.items.begin(), bk.items.begin() + bk.head);
+            bk.head = 0;
+        }
+    }
+};
+
 // --- Circular Queue ---
 class CircularQueue {
     vector<int> arr;
@@ -164,92 +537,701 @@ public:
     }
 };
 
-// --- Polynomial Linked List for Billing ---
-struct Term {
-    int coeff, pow;
-    Term* next;
-    Term(int c, int p) { coeff = c; pow = p; next = NULL; }
+// --- Dense multiplication (schoolbook / Karatsuba / NTT) ---
+// Coefficient vectors indexed by power. mulDense picks the algorithm by
+// size; the cutoffs come from the --bench-mul crossover numbers.
+const int KARATSUBA_CUTOFF = 96;
+const int NTT_CUTOFF = 12000;
+
+vector<long long> mulSchoolbook(const vector<long long> &a, const vector<long long> &b) {
+    if (a.empty() || b.empty()) return {};
+    vector<long long> r(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] == 0) continue;
+        for (size_t j = 0; j < b.size(); j++)
+            r[i + j] += a[i] * b[j];
+    }
+    return r;
+}
+
+vector<long long> mulKaratsuba(const vector<long long> &a, const vector<long long> &b) {
+    if ((int)min(a.size(), b.size()) < KARATSUBA_CUTOFF) return mulSchoolbook(a, b);
+    size_t h = max(a.size(), b.size()) / 2;
+    vector<long long> a0(a.begin(), a.begin() + min(h, a.size())), a1;
+    vector<long long> b0(b.begin(), b.begin() + min(h, b.size())), b1;
+    if (a.size() > h) a1.assign(a.begin() + h, a.end());
+    if (b.size() > h) b1.assign(b.begin() + h, b.end());
+
+    vector<long long> z0 = mulKaratsuba(a0, b0);
+    vector<long long> z2 = mulKaratsuba(a1, b1);
+    vector<long long> sa(max(a0.size(), a1.size()), 0), sb(max(b0.size(), b1.size()), 0);
+    for (size_t i = 0; i < a0.size(); i++) sa[i] += a0[i];
+    for (size_t i = 0; i < a1.size(); i++) sa[i] += a1[i];
+    for (size_t i = 0; i < b0.size(); i++) sb[i] += b0[i];
+    for (size_t i = 0; i < b1.size(); i++) sb[i] += b1[i];
+    vector<long long> z1 = mulKaratsuba(sa, sb);
+    for (size_t i = 0; i < z0.size(); i++) z1[i] -= z0[i];
+    for (size_t i = 0; i < z2.size(); i++) z1[i] -= z2[i];
+
+    vector<long long> r(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < z0.size(); i++) r[i] += z0[i];
+    for (size_t i = 0; i < z1.size() && i + h < r.size(); i++) r[i + h] += z1[i];
+    for (size_t i = 0; i < z2.size(); i++) r[i + 2 * h] += z2[i];
+    return r;
+}
+
+// NTT over three primes, then CRT (Garner) back to exact 64-bit results.
+// Exact as long as every product coefficient fits in a long long.
+const uint32_t NTT_PRIMES[3] = {998244353u, 167772161u, 469762049u};
+
+uint64_t powMod(uint64_t b, uint64_t e, uint64_t m) {
+    uint64_t r = 1;
+    b %= m;
+    while (e) {
+        if (e & 1) r = r * b % m;
+        b = b * b % m;
+        e >>= 1;
+    }
+    return r;
+}
+
+void ntt(vector<uint32_t> &a, bool invert, uint32_t mod) {
+    int n = a.size();
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) swap(a[i], a[j]);
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        uint64_t w = powMod(3, (mod - 1) / len, mod);  // 3 is a root for all three primes
+        if (invert) w = powMod(w, mod - 2, mod);
+        for (int i = 0; i < n; i += len) {
+            uint64_t wn = 1;
+            for (int j = 0; j < len / 2; j++) {
+                uint32_t u = a[i + j];
+                uint32_t v = (uint32_t)(a[i + j + len / 2] * wn % mod);
+                a[i + j] = (u + v >= mod) ? u + v - mod : u + v;
+                a[i + j + len / 2] = (u >= v) ? u - v : u + mod - v;
+                wn = wn * w % mod;
+            }
+        }
+    }
+    if (invert) {
+        uint64_t nInv = powMod(n, mod - 2, mod);
+        for (uint32_t &x : a) x = (uint32_t)(x * nInv % mod);
+    }
+}
+
+vector<long long> mulNTT(const vector<long long> &a, const vector<long long> &b) {
+    if (a.empty() || b.empty()) return {};
+    size_t need = a.size() + b.size() - 1, n = 1;
+    while (n < need) n <<= 1;
+
+    vector<uint32_t> res[3];
+    for (int p = 0; p < 3; p++) {
+        uint32_t m = NTT_PRIMES[p];
+        vector<uint32_t> fa(n, 0), fb(n, 0);
+        for (size_t i = 0; i < a.size(); i++) fa[i] = (uint32_t)(((a[i] % (long long)m) + m) % m);
+        for (size_t i = 0; i < b.size(); i++) fb[i] = (uint32_t)(((b[i] % (long long)m) + m) % m);
+        ntt(fa, false, m);
+        ntt(fb, false, m);
+        for (size_t i = 0; i < n; i++) fa[i] = (uint32_t)((uint64_t)fa[i] * fb[i] % m);
+        ntt(fa, true, m);
+        res[p] = fa;
+    }
+
+    const uint64_t m1 = NTT_PRIMES[0], m2 = NTT_PRIMES[1], m3 = NTT_PRIMES[2];
+    const uint64_t m1InvM2 = powMod(m1, m2 - 2, m2);
+    const uint64_t m12InvM3 = powMod(m1 * m2 % m3, m3 - 2, m3);
+    const __int128 M = (__int128)m1 * m2 * m3;
+    vector<long long> r(need);
+    for (size_t i = 0; i < need; i++) {
+        uint64_t x1 = res[0][i];
+        uint64_t x2 = (res[1][i] + m2 - x1 % m2) % m2 * m1InvM2 % m2;
+        uint64_t t = (x1 + x2 % m3 * (m1 % m3)) % m3;
+        uint64_t x3 = (res[2][i] + m3 - t) % m3 * m12InvM3 % m3;
+        __int128 v = (__int128)x1 + (__int128)x2 * m1 + (__int128)x3 * m1 * m2;
+        if (v > M / 2) v -= M;
+        r[i] = (long long)v;
+    }
+    return r;
+}
+
+vector<long long> mulDense(const vector<long long> &a, const vector<long long> &b) {
+    size_t small = min(a.size(), b.size());
+    if ((int)small < KARATSUBA_CUTOFF) return mulSchoolbook(a, b);
+    if ((int)small < NTT_CUTOFF) return mulKaratsuba(a, b);
+    return mulNTT(a, b);
+}
+
+// --- Sparse Polynomial Engine for Billing ---
+// Terms live in one contiguous array sorted by power (highest first),
+// which is what add / multiply / batch evaluation need.
+struct PolyTerm {
+    long long coeff;
+    int pow;
 };
 
-class Polynomial {
+class SparsePoly {
 public:
-    Term* head;
-    Polynomial() { head = NULL; }
+    // Canonical form: one term per power, no zero coefficients. hash is
+    // the sum of per-term hashes, so a single term can be added or removed
+    // in O(1). Change terms only through the members (or call rehash()).
+    vector<PolyTerm> terms;
+    uint64_t hash = 0;
 
-    void insert(int c, int p) {
-        Term* t = new Term(c, p);
-        if (head == NULL || head->pow < p) {
-            t->next = head;
-            head = t;
-            return;
+    static uint64_t termHash(long long c, int p) {
+        uint64_t z = (uint64_t)c * 0x9E3779B97F4A7C15ULL ^ ((uint64_t)(uint32_t)p << 32 | 0x5bd1e995u);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    void rehash() {
+        hash = 0;
+        for (const PolyTerm &t : terms) hash += termHash(t.coeff, t.pow);
+    }
+
+    // like powers are merged, a term that cancels out is removed
+    void insert(long long c, int p) {
+        auto it = lower_bound(terms.begin(), terms.end(), p,
+                              [](const PolyTerm &t, int pw) { return t.pow > pw; });
+        if (it != terms.end() && it->pow == p) {
+            hash -= termHash(it->coeff, p);
+            it->coeff += c;
+            if (it->coeff == 0) terms.erase(it);
+            else hash += termHash(it->coeff, p);
+        } else if (c != 0) {
+            terms.insert(it, {c, p});
+            hash += termHash(c, p);
         }
-        Term* temp = head;
-        while (temp->next != NULL && temp->next->pow >= p)
-            temp = temp->next;
-        t->next = temp->next;
-        temp->next = t;
     }
 
-    bool same(Polynomial &b) {
-        Term* a1 = head;
-        Term* a2 = b.head;
-        while (a1 && a2) {
-            if (a1->coeff != a2->coeff || a1->pow != a2->pow)
+    // different hashes settle most mismatches in O(1)
+    bool same(const SparsePoly &b) const {
+        if (hash != b.hash || terms.size() != b.terms.size()) return false;
+        for (size_t i = 0; i < terms.size(); i++)
+            if (terms[i].coeff != b.terms[i].coeff || terms[i].pow != b.terms[i].pow)
                 return false;
-            a1 = a1->next;
-            a2 = a2->next;
+        return true;
+    }
+
+    // merge of two sorted arrays, like terms combined, zeros dropped
+    SparsePoly add(const SparsePoly &b) const {
+        SparsePoly r;
+        r.terms.reserve(terms.size() + b.terms.size());
+        size_t i = 0, j = 0;
+        while (i < terms.size() || j < b.terms.size()) {
+            PolyTerm t;
+            if (j == b.terms.size() || (i < terms.size() && terms[i].pow > b.terms[j].pow))
+                t = terms[i++];
+            else if (i == terms.size() || b.terms[j].pow > terms[i].pow)
+                t = b.terms[j++];
+            else
+                t = {terms[i].coeff + b.terms[j++].coeff, terms[i++].pow};
+            if (!r.terms.empty() && r.terms.back().pow == t.pow)
+                r.terms.back().coeff += t.coeff;
+            else
+                r.terms.push_back(t);
+            if (r.terms.back().coeff == 0) r.terms.pop_back();
+        }
+        r.rehash();
+        return r;
+    }
+
+    // Heap based sparse multiply: one cursor per term of *this into b,
+    // the max-heap always gives the next highest product power, so the
+    // output comes out sorted and like terms are merged on the fly.
+    SparsePoly multiply(const SparsePoly &b) const {
+        SparsePoly r;
+        if (terms.empty() || b.terms.empty()) return r;
+        if (isDense() && b.isDense()) {
+            r.fromDense(mulDense(toDense(), b.toDense()));
+            return r;
+        }
+        struct Cursor { int pow; int i, j; };
+        auto cmp = [](const Cursor &x, const Cursor &y) { return x.pow < y.pow; };
+        priority_queue<Cursor, vector<Cursor>, decltype(cmp)> heap(cmp);
+        for (int i = 0; i < (int)terms.size(); i++)
+            heap.push({terms[i].pow + b.terms[0].pow, i, 0});
+        while (!heap.empty()) {
+            Cursor c = heap.top();
+            heap.pop();
+            long long v = terms[c.i].coeff * b.terms[c.j].coeff;
+            if (!r.terms.empty() && r.terms.back().pow == c.pow) {
+                r.terms.back().coeff += v;
+            } else {
+                if (!r.terms.empty() && r.terms.back().coeff == 0) r.terms.pop_back();
+                r.terms.push_back({v, c.pow});
+            }
+            if (c.j + 1 < (int)b.terms.size())
+                heap.push({terms[c.i].pow + b.terms[c.j + 1].pow, c.i, c.j + 1});
+        }
+        if (!r.terms.empty() && r.terms.back().coeff == 0) r.terms.pop_back();
+        r.rehash();
+        return r;
+    }
+
+    // worth switching to coefficient vectors: many terms, few gaps
+    bool isDense() const {
+        if ((int)terms.size() < KARATSUBA_CUTOFF || terms.back().pow < 0) return false;
+        return terms.size() * 4 >= (size_t)terms[0].pow + 1;
+    }
+
+    vector<long long> toDense() const {
+        vector<long long> d(terms.empty() ? 0 : terms[0].pow + 1, 0);
+        for (const PolyTerm &t : terms) d[t.pow] += t.coeff;
+        return d;
+    }
+
+    void fromDense(const vector<long long> &d) {
+        terms.clear();
+        for (int p = (int)d.size() - 1; p >= 0; p--)
+            if (d[p] != 0) terms.push_back({d[p], p});
+        rehash();
+    }
+
+    // Horner's rule run over a whole batch of x values at once.
+    // The inner loops go over the batch, so the compiler can vectorize
+    // them; blocks of 256 keep the accumulators in L1 cache.
+    void evaluateBatch(const double* xs, double* out, size_t count) const {
+        const size_t BLOCK = 256;
+        for (size_t base = 0; base < count; base += BLOCK) {
+            size_t n = min(BLOCK, count - base);
+            const double* x = xs + base;
+            double* acc = out + base;
+            for (size_t j = 0; j < n; j++) acc[j] = 0;
+            if (terms.empty()) continue;
+            for (size_t t = 0; t < terms.size(); t++) {
+                int gap = (t == 0) ? 0 : terms[t - 1].pow - terms[t].pow;
+                mulPow(acc, x, n, gap);
+                double c = (double)terms[t].coeff;
+                for (size_t j = 0; j < n; j++) acc[j] += c;
+            }
+            mulPow(acc, x, n, terms.back().pow);
+        }
+    }
+
+    double evaluate(double x) const {
+        double r;
+        evaluateBatch(&x, &r, 1);
+        return r;
+    }
+
+private:
+    // acc[j] *= x[j]^gap
+    static void mulPow(double* acc, const double* x, size_t n, int gap) {
+        if (gap <= 8) {
+            for (int g = 0; g < gap; g++)
+                for (size_t j = 0; j < n; j++) acc[j] *= x[j];
+        } else {
+            for (size_t j = 0; j < n; j++) acc[j] *= std::pow(x[j], gap);
         }
-        return (a1 == NULL && a2 == NULL);
+    }
+};
+
+// --- Polynomial for Billing ---
+// Same API as before, now a thin adapter over SparsePoly.
+class Polynomial {
+public:
+    SparsePoly poly;
+
+    void insert(int c, int p) { poly.insert(c, p); }
+
+    bool same(Polynomial &b) { return poly.same(b.poly); }
+
+    Polynomial add(Polynomial &b) {
+        Polynomial r;
+        r.poly = poly.add(b.poly);
+        return r;
+    }
+
+    Polynomial multiply(Polynomial &b) {
+        Polynomial r;
+        r.poly = poly.multiply(b.poly);
+        return r;
+    }
+
+    void evaluateBatch(const vector<double> &xs, vector<double> &out) {
+        out.resize(xs.size());
+        poly.evaluateBatch(xs.data(), out.data(), xs.size());
     }
 
     void print() {
-        if (head == NULL) { cout << "0\n"; return; }
-        Term* t = head;
-        while (t != NULL) {
-            cout << t->coeff << "x^" << t->pow;
-            if (t->next != NULL) cout << " + ";
-            t = t->next;
+        if (poly.terms.empty()) { cout << "0\n"; return; }
+        for (size_t i = 0; i < poly.terms.size(); i++) {
+            cout << poly.terms[i].coeff << "x^" << poly.terms[i].pow;
+            if (i + 1 < poly.terms.size()) cout << " + ";
         }
         cout << "\n";
     }
 };
 
+// Groups identical bills (same canonical form). Bills are bucketed by hash
+// and each bucket is confirmed with a full compare, so a hash collision can
+// never put two different bills in one group. Only groups of two or more
+// are returned, as indexes into bills, in first-seen order.
+vector<vector<int>> findDuplicateBills(const vector<Polynomial> &bills) {
+    unordered_map<uint64_t, vector<int>> firstOf;  // hash -> group numbers
+    vector<vector<int>> groups;
+    for (int i = 0; i < (int)bills.size(); i++) {
+        vector<int> &cands = firstOf[bills[i].poly.hash];
+        bool placed = false;
+        for (int g : cands)
+            if (bills[groups[g][0]].poly.same(bills[i].poly)) {
+                groups[g].push_back(i);
+                placed = true;
+                break;
+            }
+        if (!placed) {
+            cands.push_back(groups.size());
+            groups.push_back({i});
+        }
+    }
+    vector<vector<int>> dups;
+    for (auto &g : groups)
+        if (g.size() > 1) dups.push_back(move(g));
+    return dups;
+}
+
+// --- Clock (injectable, so tests can drive time by hand) ---
+class Clock {
+public:
+    virtual uint64_t now() = 0;
+    virtual ~Clock() {}
+};
+
+// milliseconds since the clock was created
+class SteadyClock : public Clock {
+    chrono::steady_clock::time_point start;
+public:
+    SteadyClock() { start = chrono::steady_clock::now(); }
+    uint64_t now() {
+        return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    }
+};
+
+class ManualClock : public Clock {
+    uint64_t t;
+public:
+    ManualClock() { t = 0; }
+    uint64_t now() { return t; }
+    void advance(uint64_t d) { t += d; }
+};
+
+// --- Hierarchical Timing Wheel ---
+// 4 levels x 256 slots, one tick per clock unit. A timer sits in the
+// level that matches how far away it is and moves down one level when
+// the lower wheel wraps around (cascade). Timers are kept in a pool and
+// linked through indexes, so schedule and cancel are O(1).
+class TimingWheel {
+    static const int LEVELS = 4;
+    static const int BITS = 8;
+    static const int SLOTS = 1 << BITS;
+
+    struct Timer {
+        uint64_t expires;
+        int item;
+        int prev, next;
+        int slot;  // level * SLOTS + slot, -1 when free
+    };
+
+    vector<Timer> timers;
+    vector<int> freeList;
+    vector<int> heads;
+    uint64_t current;
+    int active;
+
+    // earliest is current while cascading (that slot is handled right
+    // after), otherwise current + 1 so an overdue timer fires next tick
+    void link(int h, uint64_t earliest) {
+        Timer &t = timers[h];
+        uint64_t at = max(t.expires, earliest);
+        uint64_t delta = at - current;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= ((uint64_t)1 << (BITS * (level + 1)))) level++;
+        if (delta >= ((uint64_t)1 << (BITS * LEVELS))) at = current + ((uint64_t)1 << (BITS * LEVELS)) - 1;
+        int slot = level * SLOTS + (int)((at >> (BITS * level)) & (SLOTS - 1));
+        t.slot = slot;
+        t.prev = -1;
+        t.next = heads[slot];
+        if (t.next != -1) timers[t.next].prev = h;
+        heads[slot] = h;
+    }
+
+    void unlink(int h) {
+        Timer &t = timers[h];
+        if (t.prev != -1) timers[t.prev].next = t.next;
+        else heads[t.slot] = t.next;
+        if (t.next != -1) timers[t.next].prev = t.prev;
+    }
+
+    // move every timer of a higher level slot down to where it belongs now
+    void cascade(int level) {
+        int slot = level * SLOTS + (int)((current >> (BITS * level)) & (SLOTS - 1));
+        int h = heads[slot];
+        heads[slot] = -1;
+        while (h != -1) {
+            int next = timers[h].next;
+            link(h, current);
+            h = next;
+        }
+    }
+
+public:
+    TimingWheel(uint64_t start = 0) {
+        heads.assign(LEVELS * SLOTS, -1);
+        current = start;
+        active = 0;
+    }
+
+    int size() { return active; }
+    uint64_t now() { return current; }
+
+    // returns a handle for cancel()
+    int schedule(uint64_t expires, int item) {
+        int h;
+        if (!freeList.empty()) {
+            h = freeList.back();
+            freeList.pop_back();
+        } else {
+            h = timers.size();
+            timers.push_back(Timer());
+        }
+        timers[h].expires = expires;
+        timers[h].item = item;
+        link(h, current + 1);
+        active++;
+        return h;
+    }
+
+    uint64_t expiresAt(int h) { return timers[h].expires; }
+
+    bool cancel(int h) {
+        if (h < 0 || h >= (int)timers.size() || timers[h].slot == -1) return false;
+        unlink(h);
+        timers[h].slot = -1;
+        freeList.push_back(h);
+        active--;
+        return true;
+    }
+
+    // advance to `now`, calling onExpire(item) for every timer that is due
+    template <class F>
+    void advance(uint64_t now, F onExpire) {
+        while (current < now) {
+            if (active == 0) {
+                current = now;
+                break;
+            }
+            current++;
+            for (int level = 1; level < LEVELS; level++) {
+                if ((current & (((uint64_t)1 << (BITS * level)) - 1)) != 0) break;
+                cascade(level);
+            }
+            int slot = (int)(current & (SLOTS - 1));
+            int h = heads[slot];
+            heads[slot] = -1;
+            while (h != -1) {
+                int next = timers[h].next;
+                int item = timers[h].item;
+                timers[h].slot = -1;
+                freeList.push_back(h);
+                active--;
+                onExpire(item);
+                h = next;
+            }
+        }
+    }
+
+    size_t memoryBytes() {
+        return timers.capacity() * sizeof(Timer) + freeList.capacity() * sizeof(int)
+               + heads.size() * sizeof(int);
+    }
+};
+
 // --- Main System Class ---
+// per ticket bookkeeping, indexed by ticket ID
+struct TicketMeta {
+    int priority;       // current priority, -1 once the ticket is closed or undone
+    int timer;          // deadline handle in the timing wheel, -1 if none
+    uint32_t name, issue;
+    bool closed;        // closed for good: undo and redo leave it alone
+    bool inRing;        // has an entry in the round-robin queue
+};
+
 class SupportSystem {
 public:
     TicketList list;
-    UndoStack undo;
-    priority_queue<PQItem, vector<PQItem>, Compare> pq;
+    StringPool pool;
+    UndoStack undo, redo;
+    Journal journal;
+    BucketQueue<PQItem> pq;
     CircularQueue cq;
+    DrrScheduler fair;
     Polynomial b1, b2;
     int nextId;
+    bool replaying;
+    vector<TicketMeta> meta;
+    SteadyClock steadyClock;
+    Clock* clock;
+    TimingWheel wheel;
 
     SupportSystem() {
         nextId = 1;
+        replaying = false;
         cq = CircularQueue(15);
+        clock = &steadyClock;
+    }
+
+    // tests pass a ManualClock here. Pending deadlines move to a wheel on
+    // the new clock and keep the time they had left.
+    void setClock(Clock* c) {
+        TimingWheel old = wheel;
+        uint64_t was = clock->now();
+        clock = c;
+        wheel = TimingWheel(c->now());
+        for (int id = 1; id < (int)meta.size(); id++) {
+            if (meta[id].timer == -1) continue;
+            uint64_t at = old.expiresAt(meta[id].timer);
+            meta[id].timer = wheel.schedule(c->now() + (at > was ? at - was : 0), id);
+        }
+    }
+
+    uint32_t internString(const string &s) {
+        bool isNew;
+        uint32_t sid = pool.intern(s, isNew);
+        if (isNew && !replaying && journal.isOpen()) journal.logString(s);
+        return sid;
+    }
+
+    // same as addTicket but without printing, used by replay and benchmarks
+    int createTicket(string n, string i, int p) {
+        int id = nextId++;
+        uint32_t nameId = internString(n);
+        uint32_t issueId = internString(i);
+        list.addTicket(id, n, i, p);
+        if ((int)meta.size() <= id) meta.resize(id + 1, {-1, -1, 0, 0, false, false});
+        meta[id] = {p, -1, nameId, issueId, false, false};
+        undo.push({OP_ADD, (uint32_t)id, nameId, issueId, p});
+        redo.clear();
+        // replay queues only the tickets still open once it is done
+        if (!replaying) enqueue(id);
+        if (!replaying && journal.isOpen()) journal.logAdd(id, nameId, issueId, p);
+        return id;
+    }
+
+    bool waiting(int id) { return id > 0 && id < (int)meta.size() && meta[id].priority != -1; }
+
+    // give an open ticket an entry in every scheduling queue; the ring
+    // never holds two live entries for the same ticket
+    void enqueue(int id) {
+        TicketMeta &m = meta[id];
+        pq.push(m.priority, {id, m.priority, pool.get(m.name), pool.get(m.issue)});
+        if (!m.inRing && !cq.isFull()) {
+            cq.enqueue(id);
+            m.inRing = true;
+        }
+        fair.push(id, m.priority);
     }
 
     void addTicket(string n, string i, int p) {
-        list.addTicket(nextId, n, i, p);
-        Action a = {"ADD", nextId, n, i, p};
+        if (cq.isFull()) cout << "Queue is full.\n";
+        int id = createTicket(n, i, p);
+        cout << "Ticket created with ID " << id << "\n";
+    }
+
+    // returns id of the ticket the action was about, or -1. A ticket that
+    // was closed in the meantime stays closed: undo and redo skip it.
+    int undoAction() {
+        if (undo.empty()) return -1;
+        Action a = undo.top();
+        undo.pop();
+        if (!replaying && journal.isOpen()) journal.logOp(OP_UNDO);
+        if (a.op == OP_ADD && !meta[a.id].closed) {
+            list.deleteTicket(a.id);
+            cancelDeadline(a.id);
+            meta[a.id].priority = -1;  // queue entries for it are now stale
+        }
+        redo.push(a);
+        return a.id;
+    }
+
+    int redoAction() {
+        if (redo.empty()) return -1;
+        Action a = redo.top();
+        redo.pop();
+        if (!replaying && journal.isOpen()) journal.logOp(OP_REDO);
+        if (a.op == OP_ADD && !meta[a.id].closed) {
+            list.addTicket(a.id, pool.get(a.name), pool.get(a.issue), a.priority);
+            meta[a.id].priority = a.priority;
+            if (!replaying) enqueue(a.id);
+        }
         undo.push(a);
-        pq.push({nextId, p, n, i});
-        cq.enqueue(nextId);
-        cout << "Ticket created with ID " << nextId << "\n";
-        nextId++;
+        return a.id;
     }
 
     void undoLast() {
-        if (undo.empty()) {
+        int id = undoAction();
+        if (id == -1) {
             cout << "Nothing to undo.\n";
             return;
         }
-        Action a = undo.top();
-        undo.pop();
-        if (a.type == "ADD") {
-            list.deleteTicket(a.id);
-            cout << "Undo: Ticket " << a.id << " removed.\n";
+        if (meta[id].closed) cout << "Undo: Ticket " << id << " is already closed.\n";
+        else cout << "Undo: Ticket " << id << " removed.\n";
+    }
+
+    void redoLast() {
+        int id = redoAction();
+        if (id == -1) {
+            cout << "Nothing to redo.\n";
+            return;
+        }
+        if (meta[id].closed) cout << "Redo: Ticket " << id << " is closed, not restored.\n";
+        else cout << "Redo: Ticket " << id << " restored.\n";
+    }
+
+    void closeTicket(int id) {
+        list.deleteTicket(id);
+        if (id > 0 && id < (int)meta.size()) {
+            cancelDeadline(id);
+            meta[id].priority = -1;
+            meta[id].closed = true;
         }
+        if (!replaying && journal.isOpen()) journal.logDone(id);
+    }
+
+    // --- Deadlines and escalation ---
+    // ticket must be handled within `ticks` clock units or it gets escalated
+    void setDeadline(int id, uint64_t ticks) {
+        if (id <= 0 || id >= (int)meta.size() || meta[id].priority == -1) return;
+        cancelDeadline(id);
+        meta[id].timer = wheel.schedule(clock->now() + ticks, id);
+    }
+
+    void cancelDeadline(int id) {
+        if (meta[id].timer != -1) wheel.cancel(meta[id].timer);
+        meta[id].timer = -1;
+    }
+
+    // Call regularly. Every ticket whose deadline passed jumps to
+    // priority 0 (most urgent) in the priority queue and to the most urgent
+    // DRR class; the old entries become stale and are skipped when popped.
+    // Returns how many tickets were escalated.
+    int tick() {
+        int escalated = 0;
+        wheel.advance(clock->now(), [&](int id) {
+            TicketMeta &m = meta[id];
+            m.timer = -1;
+            if (m.priority <= 0) return;
+            bool moves = fair.classOf(0) != fair.classOf(m.priority);
+            m.priority = 0;
+            pq.push(0, {id, 0, pool.get(m.name), pool.get(m.issue)});
+            if (moves) fair.push(id, 0);
+            escalated++;
+        });
+        return escalated;
     }
 
     void processPriority() {
@@ -258,22 +1240,71 @@ public:
             return;
         }
         cout << "Processing urgent tickets:\n";
+        int id;
+        while ((id = nextByPriority()) != -1) {
+            cout << "ID " << id << " (" << pool.get(meta[id].name) << ") done.\n";
+            closeTicket(id);
+        }
+    }
+
+    // Next ticket each policy would handle, or -1. Entries of closed,
+    // undone or escalated (stale priority) tickets are dropped on the way.
+    int nextByPriority() {
         while (!pq.empty()) {
             PQItem x = pq.top();
             pq.pop();
-            cout << "ID " << x.id << " (" << x.name << ") done.\n";
-            list.deleteTicket(x.id);
+            if (x.priority == meta[x.id].priority) return x.id;
         }
+        return -1;
+    }
+
+    int nextInRing() {
+        int id;
+        while (cq.dequeue(id)) {
+            meta[id].inRing = false;
+            if (waiting(id)) return id;
+        }
+        return -1;
+    }
+
+    // an entry is stale once the ticket's priority moved it to another class
+    int nextFair() {
+        int id, c;
+        while (fair.pop(id, c))
+            if (waiting(id) && fair.classOf(meta[id].priority) == c) return id;
+        return -1;
     }
 
     void processRoundRobin(int count) {
         cout << "Round robin start:\n";
         for (int k = 0; k < count; k++) {
-            int id;
-            if (!cq.dequeue(id)) break;
-            Ticket* t = list.getTicket(id);
-            if (t != NULL)
-                cout << "Cycle " << (k + 1) << ": Working on ID " << id << " - " << t->name << "\n";
+            int id = nextInRing();
+            if (id == -1) break;
+            cout << "Cycle " << (k + 1) << ": Working on ID " << id << " - " << pool.get(meta[id].name) << "\n";
+        }
+    }
+
+    // weighted fair processing: per-priority queues served by DRR,
+    // so low priority tickets still get their share
+    void processFair(int count) {
+        cout << "Fair (DRR) processing:\n";
+        int done = 0;
+        int id;
+        while (done < count && (id = nextFair()) != -1) {
+            cout << "ID " << id << " (" << pool.get(meta[id].name) << ") done, class "
+                 << fair.classOf(meta[id].priority) << ".\n";
+            closeTicket(id);
+            done++;
+        }
+        if (done == 0) cout << "No tickets waiting.\n";
+    }
+
+    // run whichever policy was chosen at runtime
+    void process(SchedPolicy policy, int count) {
+        switch (policy) {
+            case POLICY_PRIORITY: processPriority(); break;
+            case POLICY_ROUND_ROBIN: processRoundRobin(count); break;
+            case POLICY_DRR: processFair(count); break;
         }
     }
 
@@ -283,11 +1314,821 @@ public:
         if (b1.same(b2)) cout << "Records are same.\n";
         else cout << "Records are different.\n";
     }
+
+    // Rebuild state after a crash by replaying the journal.
+    // A torn record at the tail is cut off so new appends start clean.
+    // Returns the number of records applied.
+    long long replay(string path) {
+        JournalReader r;
+        if (!r.load(path)) return 0;
+        replaying = true;
+        long long applied = 0;
+        size_t good = 0;
+        bool ok = true;
+        while (!r.atEnd() && ok) {
+            uint8_t op;
+            uint64_t id, nm, is, pr;
+            string str;
+            r.getByte(op);
+            switch (op) {
+                case OP_STR:
+                    ok = r.getVarint(id) && r.getString(str, id);
+                    if (ok) internString(str);
+                    break;
+                case OP_ADD:
+                    ok = r.getVarint(id) && r.getVarint(nm) && r.getVarint(is) && r.getVarint(pr)
+                         && nm < (uint64_t)pool.size() && is < (uint64_t)pool.size();
+                    if (ok) {
+                        nextId = id;
+                        createTicket(pool.get(nm), pool.get(is), (int)((pr >> 1) ^ (~(pr & 1) + 1)));
+                    }
+                    break;
+                case OP_DONE:
+                    ok = r.getVarint(id);
+                    if (ok) closeTicket(id);
+                    break;
+                case OP_UNDO:
+                    undoAction();
+                    break;
+                case OP_REDO:
+                    redoAction();
+                    break;
+                default:
+                    ok = false;
+            }
+            if (ok) {
+                applied++;
+                good = r.position();
+            }
+        }
+        replaying = false;
+        // queue what is still open, in ID (creation) order
+        for (int id = 1; id < (int)meta.size(); id++)
+            if (waiting(id)) enqueue(id);
+        if (good < r.size()) {
+            truncateFile(path, good);
+            cout << "Journal: dropped " << (r.size() - good) << " bytes of torn tail.\n";
+        }
+        return applied;
+    }
+};
+
+// --- Undo / redo stress check ---
+// Random create / undo / redo / close sequences, checked against a plain
+// model of what should be open: undo takes back a creation, redo repeats
+// it, and a closed ticket never comes back. Then every policy is drained
+// and may only hand out open tickets, each once.
+bool stressUndo(int rounds, int ops) {
+    bool allOk = true;
+    for (int round = 0; round < rounds; round++) {
+        bool ok = true;
+        // fixed case first: close, then undo and redo the creation
+        {
+            SupportSystem sys;
+            int id = sys.createTicket("Diana", "Login not working", 1);
+            sys.closeTicket(id);
+            sys.undoAction();
+            sys.redoAction();
+            if (sys.waiting(id) || sys.list.getTicket(id) != NULL || sys.nextByPriority() != -1
+                || sys.nextInRing() != -1 || sys.nextFair() != -1) ok = false;
+        }
+        for (int pol = 0; pol < 3; pol++) {
+            SupportSystem sys;
+            mt19937 rng(round * 3 + pol);
+            vector<int> undoIds, redoIds;
+            set<int> open, closed;
+            for (int k = 0; k < ops; k++) {
+                int r = rng() % 10;
+                if (r < 5) {
+                    int id = sys.createTicket("T" + to_string(k), "Issue", 1 + rng() % 5);
+                    open.insert(id);
+                    undoIds.push_back(id);
+                    redoIds.clear();
+                } else if (r < 7) {
+                    sys.undoAction();
+                    if (!undoIds.empty()) {
+                        open.erase(undoIds.back());
+                        redoIds.push_back(undoIds.back());
+                        undoIds.pop_back();
+                    }
+                } else if (r < 9) {
+                    sys.redoAction();
+                    if (!redoIds.empty()) {
+                        if (!closed.count(redoIds.back())) open.insert(redoIds.back());
+                        undoIds.push_back(redoIds.back());
+                        redoIds.pop_back();
+                    }
+                } else if (sys.nextId > 1) {
+                    int id = 1 + rng() % (sys.nextId - 1);
+                    sys.closeTicket(id);
+                    open.erase(id);
+                    closed.insert(id);
+                }
+            }
+            set<int> listed, seen;
+            for (Ticket* t = sys.list.head; t != NULL; t = t->next) listed.insert(t->id);
+            if (listed != open) ok = false;
+            for (int id = 1; id < sys.nextId; id++)
+                if (sys.waiting(id) != (open.count(id) > 0)) ok = false;
+            while (ok) {
+                int id = pol == 0 ? sys.nextByPriority() : pol == 1 ? sys.nextInRing() : sys.nextFair();
+                if (id == -1) break;
+                if (!open.count(id) || !seen.insert(id).second) ok = false;
+                if (pol != 1) sys.closeTicket(id);
+            }
+            if (pol != 1 && seen != open) ok = false;
+        }
+        cout << "round " << round + 1 << ": " << ops << " random operations, priority / rr / drr "
+             << (ok ? "OK" : "FAILED") << "\n";
+        allOk = allOk && ok;
+    }
+    return allOk;
+}
+
+// --- Journal benchmark: bytes per op and replay speed ---
+void benchJournal(int n) {
+    string path = "journal_bench.bin";
+    remove(path.c_str());
+    string names[] = {"Diana", "Ethan", "Frank", "Grace", "Hina", "Ivan", "Jai", "Kavya"};
+    string issues[] = {"Login not working", "App crashes", "Payment issue", "Refund pending", "Slow loading"};
+
+    SupportSystem sys;
+    sys.journal.open(path, 256);
+    auto start = chrono::steady_clock::now();
+    // most tickets get closed right away so the list walk stays short
+    for (int k = 0; k < n; k++) {
+        int id = sys.createTicket(names[k % 8], issues[k % 5], 1 + k % 5);
+        if (k % 10 == 9) { sys.undoAction(); sys.redoAction(); }
+        if (k % 1000 != 0) sys.closeTicket(id);
+    }
+    sys.journal.close();
+    double writeSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long ops = sys.journal.records;
+    long long bytes = sys.journal.bytesWritten;
+
+    SupportSystem back;
+    start = chrono::steady_clock::now();
+    long long applied = back.replay(path);
+    double replaySec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    int left1 = 0, left2 = 0;
+    for (Ticket* t = sys.list.head; t != NULL; t = t->next) left1++;
+    for (Ticket* t = back.list.head; t != NULL; t = t->next) left2++;
+
+    cout << "Operations journaled : " << ops << " (" << sys.journal.syncs << " fsyncs)\n";
+    cout << "Journal size         : " << bytes << " bytes\n";
+    cout << "Bytes per operation  : " << fixed << setprecision(2) << (double)bytes / ops << "\n";
+    cout << "Old Action size      : " << sizeof(string) * 3 + sizeof(int) * 2 << "+ bytes in memory\n";
+    cout << "Write time           : " << writeSec * 1000 << " ms\n";
+    cout << "Replay               : " << applied << " records in " << replaySec * 1000 << " ms ("
+         << (long long)(applied / max(replaySec, 1e-9)) << " records/s)\n";
+    cout << "Open tickets         : " << left1 << " live, " << left2 << " replayed"
+         << (left1 == left2 ? " (match)\n" : " (MISMATCH)\n");
+    remove(path.c_str());
+}
+
+// --- Duplicate bill benchmark ---
+// Duplicate bills among N records: hash grouping against comparing every
+// pair. Copies of a bill have their terms inserted in a different order and
+// some coefficients split over two inserts, which normalization merges.
+void benchDuplicateBills(int n) {
+    mt19937 rng(8);
+    int distinct = max(1, n / 4);
+    vector<vector<PolyTerm>> base(distinct);
+    for (auto &b : base)
+        for (int k = 0, terms = 3 + rng() % 8; k < terms; k++)
+            b.push_back({(long long)(1 + rng() % 500), (int)(rng() % 12)});
+    vector<Polynomial> bills(n);
+    for (int i = 0; i < n; i++) {
+        vector<PolyTerm> t = base[rng() % distinct];
+        shuffle(t.begin(), t.end(), rng);
+        for (PolyTerm &pt : t) {
+            if (pt.coeff > 1 && rng() % 3 == 0) {
+                bills[i].insert(1, pt.pow);
+                bills[i].insert(pt.coeff - 1, pt.pow);
+            } else {
+                bills[i].insert(pt.coeff, pt.pow);
+            }
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<vector<int>> dups = findDuplicateBills(bills);
+    double hashMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // pairwise: every bill against the first member of each group so far
+    start = chrono::steady_clock::now();
+    vector<int> reps;
+    vector<int> sizes;
+    for (int i = 0; i < n; i++) {
+        bool placed = false;
+        for (size_t g = 0; g < reps.size() && !placed; g++) {
+            const SparsePoly &a = bills[reps[g]].poly, &b = bills[i].poly;
+            bool eq = a.terms.size() == b.terms.size();
+            for (size_t k = 0; eq && k < a.terms.size(); k++)
+                eq = a.terms[k].coeff == b.terms[k].coeff && a.terms[k].pow == b.terms[k].pow;
+            if (eq) { sizes[g]++; placed = true; }
+        }
+        if (!placed) { reps.push_back(i); sizes.push_back(1); }
+    }
+    double pairMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    size_t pairGroups = count_if(sizes.begin(), sizes.end(), [](int c) { return c > 1; });
+
+    size_t inGroups = 0;
+    for (auto &g : dups) inGroups += g.size();
+    cout << n << " bills, " << dups.size() << " duplicate groups covering " << inGroups << " bills\n";
+    cout << "  hash grouping    : " << hashMs << " ms\n";
+    cout << "  pairwise compare : " << pairMs << " ms"
+         << (pairGroups == dups.size() ? "  (same groups)\n" : "  (MISMATCH)\n");
+}
+
+// --- Polynomial benchmark: add, multiply, batch evaluation ---
+void benchPoly(int termCount, int xCount) {
+    mt19937 rng(42);
+    Polynomial a, b;
+    for (int k = 0; k < termCount; k++) {
+        a.insert(1 + rng() % 100, k * 3);
+        b.insert(1 + rng() % 100, k * 5 + 1);
+    }
+
+    auto start = chrono::steady_clock::now();
+    Polynomial s = a.add(b);
+    double addMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    Polynomial m = a.multiply(b);
+    double mulMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    vector<double> xs(xCount), out;
+    for (int k = 0; k < xCount; k++) xs[k] = 0.5 + (rng() % 1000) / 2000.0;
+    start = chrono::steady_clock::now();
+    a.evaluateBatch(xs, out);
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // old style: walk every term for every x with pow()
+    start = chrono::steady_clock::now();
+    double maxErr = 0;
+    for (int k = 0; k < xCount; k++) {
+        double v = 0;
+        for (const PolyTerm &t : a.poly.terms) v += t.coeff * pow(xs[k], t.pow);
+        maxErr = max(maxErr, fabs(v - out[k]) / max(1.0, fabs(v)));
+    }
+    double naiveMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Terms per input      : " << termCount << "\n";
+    cout << "Add                  : " << s.poly.terms.size() << " terms in " << addMs << " ms\n";
+    cout << "Multiply (heap)      : " << m.poly.terms.size() << " terms in " << mulMs << " ms\n";
+    cout << "Batch Horner         : " << xCount << " values in " << batchMs << " ms\n";
+    cout << "Term-by-term pow()   : " << xCount << " values in " << naiveMs << " ms\n";
+    cout << "Max relative error   : " << maxErr << "\n";
+
+    // a(x) * b(x) must match (a*b)(x)
+    vector<double> x1 = {0.99}, va, vb, vm;
+    a.evaluateBatch(x1, va);
+    b.evaluateBatch(x1, vb);
+    m.evaluateBatch(x1, vm);
+    cout << "Multiply check       : " << (fabs(va[0] * vb[0] - vm[0]) <= 1e-9 * fabs(vm[0]) ? "ok" : "FAILED") << "\n";
+}
+
+// --- Multiplication crossover benchmark ---
+double timeMul(vector<long long> (*mul)(const vector<long long>&, const vector<long long>&),
+               const vector<long long> &a, const vector<long long> &b, vector<long long> &out) {
+    int reps = 0;
+    auto start = chrono::steady_clock::now();
+    double ms = 0;
+    do {
+        out = mul(a, b);
+        reps++;
+        ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    } while (ms < 20 && reps < 1000);
+    return ms / reps;
+}
+
+// default size range for --bench-mul: keep doubling past twice the NTT
+// cutoff, so both crossovers show up in the table
+int benchMulDefaultMax() {
+    int n = 16;
+    while (n < 2 * NTT_CUTOFF) n *= 2;
+    return n;
+}
+
+void benchMul(int maxN) {
+    mt19937 rng(1);
+    cout << setw(8) << "terms" << setw(14) << "schoolbook" << setw(14) << "karatsuba"
+         << setw(14) << "ntt" << setw(12) << "fastest" << "  (ms per multiply)\n";
+    string prevBest;
+    for (int n = 16; n <= maxN; n *= 2) {
+        vector<long long> a(n), b(n), r1, r2, r3;
+        for (int i = 0; i < n; i++) {
+            a[i] = (long long)(rng() % 2001) - 1000;
+            b[i] = (long long)(rng() % 2001) - 1000;
+        }
+        double t1 = timeMul(mulSchoolbook, a, b, r1);
+        double t2 = timeMul(mulKaratsuba, a, b, r2);
+        double t3 = timeMul(mulNTT, a, b, r3);
+        string best = (t1 <= t2 && t1 <= t3) ? "schoolbook" : (t2 <= t3 ? "karatsuba" : "ntt");
+        cout << setw(8) << n << fixed << setprecision(4) << setw(14) << t1 << setw(14) << t2
+             << setw(14) << t3 << setw(12) << best;
+        if (r1 != r2 || r1 != r3) cout << "  MISMATCH";
+        if (!prevBest.empty() && best != prevBest) cout << "  <- crossover";
+        cout << "\n";
+        prevBest = best;
+    }
+    cout << "Cutoffs in use: Karatsuba from " << KARATSUBA_CUTOFF << " terms, NTT from "
+         << NTT_CUTOFF << " terms\n";
+}
+
+// --- Escalation demo and timing wheel benchmark ---
+// same deadlines under the priority and the DRR policy
+void demoEscalation() {
+    SchedPolicy policies[] = {POLICY_PRIORITY, POLICY_DRR};
+    for (SchedPolicy pol : policies) {
+        cout << "Policy: " << policyName(pol) << "\n";
+        ManualClock clk;
+        SupportSystem sys;
+        sys.setClock(&clk);
+        sys.addTicket("Diana", "Login not working", 1);
+        sys.addTicket("Ethan", "App crashes", 3);
+        sys.addTicket("Frank", "Payment issue", 5);
+        sys.setDeadline(2, 30);
+        sys.setDeadline(3, 10);
+        for (int step = 0; step < 4; step++) {
+            clk.advance(10);
+            int n = sys.tick();
+            cout << "t=" << clk.now() << ": escalated " << n << " ticket(s)\n";
+        }
+        sys.process(pol, 3);
+    }
+}
+
+void benchWheel(int n) {
+    ManualClock clk;
+    TimingWheel wheel(clk.now());
+    mt19937 rng(3);
+    vector<int> handles(n);
+    vector<uint64_t> due(n);
+
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < n; k++) {
+        due[k] = 1 + rng() % 10000000;  // up to ~2.8 hours in ms ticks
+        handles[k] = wheel.schedule(due[k], k);
+    }
+    double schedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    size_t mem = wheel.memoryBytes();
+
+    start = chrono::steady_clock::now();
+    int cancelled = 0;
+    vector<char> live(n, 1);
+    for (int k = 0; k < n; k += 2) {
+        cancelled += wheel.cancel(handles[k]);
+        live[k] = 0;
+    }
+    double cancelMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    long long fired = 0, late = 0;
+    start = chrono::steady_clock::now();
+    while (wheel.size() > 0) {
+        clk.advance(1000);
+        wheel.advance(clk.now(), [&](int item) {
+            fired++;
+            if (!live[item] || due[item] != wheel.now()) late++;
+        });
+    }
+    double runMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Timers scheduled : " << n << " in " << schedMs << " ms ("
+         << schedMs * 1e6 / n << " ns each)\n";
+    cout << "Timers cancelled : " << cancelled << " in " << cancelMs << " ms\n";
+    cout << "Timers fired     : " << fired << " over " << clk.now() << " ticks in " << runMs << " ms\n";
+    cout << "Wrong/late fires : " << late << "\n";
+    cout << "Wheel memory     : " << mem / 1024 << " KB (" << (double)mem / n << " bytes per timer)\n";
+}
+
+// --- Discrete-Event Load Simulator ---
+// Feeds generated ticket arrivals through a scheduling policy with a pool
+// of support workers and reports waiting time per priority class.
+// Times are in minutes of simulated time.
+struct SimConfig {
+    string arrivals = "poisson";   // "poisson" or "bursty"
+    double rate = 4.0;             // mean arrivals per minute
+    double burst = 4.0;            // bursty: rate multiplier while ON
+    double burstOn = 5.0;          // bursty: mean ON period
+    double burstOff = 20.0;        // bursty: mean OFF period
+    vector<double> mix = {10, 20, 30, 25, 15};  // weight of priority 1..5
+    double service = 1.0;          // mean service time (exponential)
+    int workers = 5;
+    double quantum = 0.5;          // round-robin time slice
+    int tickets = 100000;
+    unsigned seed = 1;
+    string csv = "";
+    vector<double> weights;        // DRR weight of priority 1..5 (empty = 16,8,4,2,1)
+    double drrQuantum = 1.0;       // DRR credit per turn, in minutes of work
+    vector<SchedPolicy> policies = {POLICY_PRIORITY, POLICY_ROUND_ROBIN, POLICY_DRR};
+};
+
+struct SimTicket {
+    double arrival, service, remaining, finish;
+    int priority;
 };
 
+// Ready queue for the chosen policy, built from the same classes
+// SupportSystem schedules with (BucketQueue, CircularQueue, DrrScheduler),
+// so the simulated order is the order the live system would pick.
+class SimQueue {
+    SchedPolicy policy;
+    vector<SimTicket>* tickets;
+    BucketQueue<int> pq;   // FIFO within a priority, like SupportSystem::pq
+    CircularQueue ring;    // sized to hold every ticket at once
+    DrrScheduler drr;      // cost of an item = its remaining service time
+public:
+    SimQueue(SchedPolicy p, vector<SimTicket>* t, int classes, const vector<double> &weights, double q) {
+        policy = p;
+        tickets = t;
+        ring = CircularQueue(max(1, (int)t->size()));
+        drr = DrrScheduler(classes, q);
+        if (!weights.empty()) drr.setWeights(weights);
+    }
+    bool empty() {
+        if (policy == POLICY_PRIORITY) return pq.empty();
+        if (policy == POLICY_DRR) return drr.empty();
+        return ring.isEmpty();
+    }
+    void push(int idx) {
+        if (policy == POLICY_PRIORITY) pq.push((*tickets)[idx].priority, idx);
+        else if (policy == POLICY_DRR) drr.push(idx, (*tickets)[idx].priority, (*tickets)[idx].remaining);
+        else ring.enqueue(idx);
+    }
+    int pop() {
+        int idx;
+        if (policy == POLICY_PRIORITY) {
+            idx = pq.top();
+            pq.pop();
+        } else if (policy == POLICY_DRR) {
+            drr.pop(idx);
+        } else {
+            ring.dequeue(idx);
+        }
+        return idx;
+    }
+    // how long a worker keeps the ticket before it goes back in line
+    double slice(int idx, double quantum) {
+        double rem = (*tickets)[idx].remaining;
+        return policy == POLICY_ROUND_ROBIN ? min(rem, quantum) : rem;
+    }
+};
+
+vector<SimTicket> generateArrivals(const SimConfig &cfg) {
+    mt19937_64 rng(cfg.seed);
+    exponential_distribution<double> serviceDist(1.0 / cfg.service);
+    discrete_distribution<int> mixDist(cfg.mix.begin(), cfg.mix.end());
+
+    bool bursty = cfg.arrivals == "bursty";
+    double onFrac = cfg.burstOn / (cfg.burstOn + cfg.burstOff);
+    double onRate = cfg.rate * cfg.burst;
+    double offRate = max(0.0, (cfg.rate - onFrac * onRate) / (1 - onFrac));
+    bool on = true;
+    double t = 0, switchAt = bursty ? exponential_distribution<double>(1.0 / cfg.burstOn)(rng) : 1e300;
+
+    vector<SimTicket> out;
+    out.reserve(cfg.tickets);
+    while ((int)out.size() < cfg.tickets) {
+        double r = bursty ? (on ? onRate : offRate) : cfg.rate;
+        double next = r > 0 ? t + exponential_distribution<double>(r)(rng) : 1e300;
+        if (next > switchAt) {
+            // memoryless, so just restart the draw from the switch time
+            t = switchAt;
+            on = !on;
+            switchAt = t + exponential_distribution<double>(1.0 / (on ? cfg.burstOn : cfg.burstOff))(rng);
+            continue;
+        }
+        t = next;
+        double sv = serviceDist(rng);
+        out.push_back({t, sv, sv, 0, 1 + mixDist(rng)});
+    }
+    return out;
+}
+
+struct SimResult {
+    SchedPolicy policy;
+    double makespan;
+    double busy;
+    vector<vector<double>> waits;  // per priority class
+};
+
+SimResult simulate(const SimConfig &cfg, SchedPolicy policy, vector<SimTicket> tickets) {
+    // event = (time, kind, ticket); kind 0 = slice done, 1 = arrival,
+    // so a worker frees up before a same-time arrival is queued
+    typedef tuple<double, int, int> Event;
+    priority_queue<Event, vector<Event>, greater<Event>> events;
+    for (int k = 0; k < (int)tickets.size(); k++) events.push(Event(tickets[k].arrival, 1, k));
+
+    SimQueue ready(policy, &tickets, cfg.mix.size(), cfg.weights, cfg.drrQuantum);
+    int idle = cfg.workers;
+    SimResult res;
+    res.policy = policy;
+    res.makespan = 0;
+    res.busy = 0;
+    res.waits.assign(cfg.mix.size() + 1, vector<double>());
+
+    auto dispatch = [&](double now) {
+        while (idle > 0 && !ready.empty()) {
+            int idx = ready.pop();
+            double sl = ready.slice(idx, cfg.quantum);
+            tickets[idx].remaining -= sl;
+            res.busy += sl;
+            idle--;
+            events.push(Event(now + sl, 0, idx));
+        }
+    };
+
+    while (!events.empty()) {
+        Event e = events.top();
+        events.pop();
+        double now = get<0>(e);
+        int idx = get<2>(e);
+        if (get<1>(e) == 1) {
+            ready.push(idx);
+        } else {
+            idle++;
+            if (tickets[idx].remaining > 1e-12) {
+                ready.push(idx);
+            } else {
+                tickets[idx].finish = now;
+                res.makespan = max(res.makespan, now);
+                SimTicket &t = tickets[idx];
+                res.waits[t.priority].push_back(t.finish - t.arrival - t.service);
+            }
+        }
+        dispatch(now);
+    }
+    return res;
+}
+
+double percentile(vector<double> &v, double q) {
+    if (v.empty()) return 0;
+    size_t k = min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+void runSimulation(const SimConfig &cfg) {
+    vector<SimTicket> arrivals = generateArrivals(cfg);
+    ofstream csv;
+    if (!cfg.csv.empty()) {
+        csv.open(cfg.csv);
+        csv << "policy,priority,tickets,throughput_per_min,mean_wait,p50_wait,p95_wait,p99_wait\n";
+    }
+
+    cout << "Arrivals: " << cfg.arrivals << ", rate " << cfg.rate << "/min, " << cfg.tickets
+         << " tickets, " << cfg.workers << " workers, mean service " << cfg.service << " min\n";
+    vector<vector<double>> tail;  // p99 per policy and class, for the summary
+    for (SchedPolicy pol : cfg.policies) {
+        SimResult r = simulate(cfg, pol, arrivals);
+        tail.push_back(vector<double>(r.waits.size(), 0));
+        cout << "\nPolicy: " << policyName(pol) << "  throughput " << fixed << setprecision(3)
+             << cfg.tickets / r.makespan << "/min, utilization "
+             << 100.0 * r.busy / (r.makespan * cfg.workers) << "%\n";
+        cout << setw(10) << "priority" << setw(10) << "tickets" << setw(12) << "mean"
+             << setw(12) << "p50" << setw(12) << "p95" << setw(12) << "p99" << "\n";
+        for (int p = 1; p < (int)r.waits.size(); p++) {
+            vector<double> &w = r.waits[p];
+            double mean = w.empty() ? 0 : accumulate(w.begin(), w.end(), 0.0) / w.size();
+            double p50 = percentile(w, 0.50), p95 = percentile(w, 0.95), p99 = percentile(w, 0.99);
+            tail.back()[p] = p99;
+            cout << setw(10) << p << setw(10) << w.size() << setw(12) << mean << setw(12) << p50
+                 << setw(12) << p95 << setw(12) << p99 << "\n";
+            if (csv.is_open())
+                csv << policyName(pol) << "," << p << "," << w.size() << "," << cfg.tickets / r.makespan
+                    << "," << mean << "," << p50 << "," << p95 << "," << p99 << "\n";
+        }
+    }
+    if (cfg.policies.size() > 1) {
+        cout << "\np99 wait by priority class:\n" << setw(10) << "priority";
+        for (SchedPolicy pol : cfg.policies) cout << setw(14) << policyName(pol);
+        cout << "\n";
+        for (int p = 1; p < (int)tail[0].size(); p++) {
+            cout << setw(10) << p;
+            for (size_t k = 0; k < tail.size(); k++) cout << setw(14) << tail[k][p];
+            cout << "\n";
+        }
+    }
+    if (csv.is_open()) cout << "\nCSV written to " << cfg.csv << "\n";
+}
+
+const char* SIM_USAGE =
+    "usage: --simulate [arrivals=poisson|bursty] [rate=R] [burst=B] [on=T] [off=T]\n"
+    "                  [mix=w1,w2,...] [service=S] [workers=N] [quantum=Q] [tickets=N]\n"
+    "                  [seed=N] [policy=priority|rr|drr|all] [weights=w1,w2,...]\n"
+    "                  [drrq=Q] [csv=file]\n"
+    "rate, burst, on, off, service, quantum, drrq and weights must be > 0,\n"
+    "workers and tickets >= 1, mix weights >= 0 with at least one > 0\n";
+
+// whole string must be a number
+bool parseNumber(const string &s, double &out) {
+    try {
+        size_t used;
+        out = stod(s, &used);
+        return used == s.size() && isfinite(out);
+    } catch (const exception &) {
+        return false;
+    }
+}
+
+bool parseList(const string &s, vector<double> &out) {
+    out.clear();
+    stringstream ss(s);
+    string part;
+    double v;
+    while (getline(ss, part, ',')) {
+        if (!parseNumber(part, v)) return false;
+        out.push_back(v);
+    }
+    return !out.empty();
+}
+
+// key=value arguments, e.g. rate=4 workers=5 arrivals=bursty mix=40,30,20,10
+// Returns false (after saying what is wrong) on any bad key or value.
+bool parseSimArgs(int argc, char* argv[], int from, SimConfig &cfg) {
+    for (int k = from; k < argc; k++) {
+        string arg = argv[k];
+        size_t eq = arg.find('=');
+        if (eq == string::npos) {
+            cout << "Expected key=value, got " << arg << "\n";
+            return false;
+        }
+        string key = arg.substr(0, eq), val = arg.substr(eq + 1);
+        double x = 0;
+        bool ok = true;
+        if (key == "arrivals") {
+            cfg.arrivals = val;
+            ok = val == "poisson" || val == "bursty";
+        }
+        else if (key == "csv") cfg.csv = val;
+        else if (key == "policy") {
+            SchedPolicy pol;
+            if (val == "all") cfg.policies = {POLICY_PRIORITY, POLICY_ROUND_ROBIN, POLICY_DRR};
+            else if (parsePolicy(val, pol)) cfg.policies = {pol};
+            else ok = false;
+        }
+        else if (key == "weights" || key == "mix") {
+            vector<double> &w = key == "mix" ? cfg.mix : cfg.weights;
+            ok = parseList(val, w);
+            double sum = 0;
+            for (double v : w) {
+                if (v < 0 || (key == "weights" && v == 0)) ok = false;
+                sum += v;
+            }
+            ok = ok && sum > 0;
+        }
+        else if (key == "rate" || key == "burst" || key == "on" || key == "off" || key == "service"
+                 || key == "quantum" || key == "drrq") {
+            ok = parseNumber(val, x) && x > 0;
+            if (key == "rate") cfg.rate = x;
+            else if (key == "burst") cfg.burst = x;
+            else if (key == "on") cfg.burstOn = x;
+            else if (key == "off") cfg.burstOff = x;
+            else if (key == "service") cfg.service = x;
+            else if (key == "quantum") cfg.quantum = x;
+            else cfg.drrQuantum = x;
+        }
+        else if (key == "workers" || key == "tickets" || key == "seed") {
+            ok = parseNumber(val, x) && x == floor(x) && x >= (key == "seed" ? 0 : 1) && x <= INT_MAX;
+            if (key == "workers") cfg.workers = (int)x;
+            else if (key == "tickets") cfg.tickets = (int)x;
+            else cfg.seed = (unsigned)x;
+        }
+        else {
+            cout << "Unknown option " << key << "\n";
+            return false;
+        }
+        if (!ok) {
+            cout << "Bad value for " << key << ": " << val << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Bucket queue vs binary heap benchmark ---
+template <class PQ, class Make>
+double timeStdHeap(int n, const vector<int> &prios, Make make, long long &check) {
+    PQ pq;
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < n; k++) pq.push(make(k, prios[k]));
+    // hold phase: pop one, push one, like a busy desk
+    for (int k = 0; k < n; k++) {
+        check += pq.top().priority;
+        pq.pop();
+        pq.push(make(k, prios[(k * 7) % n]));
+    }
+    while (!pq.empty()) {
+        check += pq.top().priority;
+        pq.pop();
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <class T, class Make>
+double timeBucket(int n, const vector<int> &prios, Make make, long long &check) {
+    BucketQueue<T> pq;
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < n; k++) pq.push(prios[k], make(k, prios[k]));
+    for (int k = 0; k < n; k++) {
+        check += pq.top().priority;
+        pq.pop();
+        int p = prios[(k * 7) % n];
+        pq.push(p, make(k, p));
+    }
+    while (!pq.empty()) {
+        check += pq.top().priority;
+        pq.pop();
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void benchPQ(int n) {
+    mt19937 rng(11);
+    int ranges[] = {5, 64};
+    for (int range : ranges) {
+        vector<int> prios(n);
+        for (int k = 0; k < n; k++) prios[k] = (range == 5 ? 1 : 0) + rng() % range;
+        long long c1 = 0, c2 = 0;
+        string names[] = {"Diana", "Ethan", "Frank", "Grace"};
+        auto make = [&](int k, int p) { return PQItem{k, p, names[k & 3], "Support request text"}; };
+        double heapMs = timeStdHeap<priority_queue<PQItem, vector<PQItem>, Compare>>(n, prios, make, c1);
+        double bucketMs = timeBucket<PQItem>(n, prios, make, c2);
+        cout << "Priorities " << (range == 5 ? "1..5 " : "0..63") << ", " << n << " items, push + hold + drain:\n";
+        cout << "  priority_queue<PQItem, Compare> : " << heapMs << " ms\n";
+        cout << "  BucketQueue<PQItem>         : " << bucketMs << " ms"
+             << (c1 == c2 ? "  (same priority order)\n" : "  (MISMATCH)\n");
+    }
+}
+
 // --- Driver ---
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench-journal") {
+        benchJournal(argc > 2 ? atoi(argv[2]) : 100000);
+        return 0;
+    }
+    // --process <priority|rr|drr>: demo tickets handled by the chosen policy
+    if (argc > 2 && string(argv[1]) == "--process") {
+        SchedPolicy pol;
+        if (!parsePolicy(argv[2], pol)) {
+            cout << "Unknown policy " << argv[2] << " (use priority, rr or drr)\n";
+            return 1;
+        }
+        SupportSystem sys;
+        string names[] = {"Diana", "Ethan", "Frank", "Grace", "Hina", "Ivan"};
+        for (int k = 0; k < 12; k++) sys.createTicket(names[k % 6], "Demo issue", 1 + k % 5);
+        sys.process(pol, 12);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--stress-undo") {
+        return stressUndo(argc > 2 ? atoi(argv[2]) : 20, 2000) ? 0 : 1;
+    }
+    if (argc > 1 && string(argv[1]) == "--simulate") {
+        SimConfig cfg;
+        if (!parseSimArgs(argc, argv, 2, cfg)) {
+            cout << SIM_USAGE;
+            return 1;
+        }
+        runSimulation(cfg);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-pq") {
+        benchPQ(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--demo-escalation") {
+        demoEscalation();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-wheel") {
+        benchWheel(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-mul") {
+        benchMul(argc > 2 ? atoi(argv[2]) : benchMulDefaultMax());
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-dup-bills") {
+        benchDuplicateBills(argc > 2 ? atoi(argv[2]) : 20000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-poly") {
+        benchPoly(argc > 2 ? atoi(argv[2]) : 200, argc > 3 ? atoi(argv[3]) : 1000000);
+        return 0;
+    }
+
     SupportSystem sys;
+
+    // --journal <file>: recover earlier state from the file, then log to it
+    if (argc > 2 && string(argv[1]) == "--journal") {
+        long long n = sys.replay(argv[2]);
+        cout << "Recovered " << n << " journal records, next ticket ID " << sys.nextId << "\n";
+        sys.journal.open(argv[2], 8);
+    }
+
     sys.addTicket("Diana", "Login not working", 1);
     sys.addTicket("Ethan", "App crashes", 2);
     sys.addTicket("Frank", "Payment issue", 3);
@@ -317,4 +2158,4 @@ int main() {
     sys.compareBilling();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -4,6 +4,30 @@
 #include <algorithm>
 #include <chrono>
 #include <iomanip>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <random>
+#include <unordered_map>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <new>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORT_NETWORK_AVX2 1
+#include <immintrin.h>
+#else
+#define SORT_NETWORK_AVX2 0
+#endif
 
 using namespace std;
 
@@ -37,505 +61,3302 @@ public:
     }
 };
 
-// Hash Table Node for collision handling (using chaining)
-class HashNode {
-public:
-    Student data;
-    HashNode* next;
-    
-    HashNode(Student s) {
-        data = s;
-        next = nullptr;
-    }
-};
-
 // Hash Table Class
+// Open addressing with Robin Hood probing. Each slot holds the student ID
+// inline plus the index of the record in a dense records array, so a probe
+// never leaves the slot array. On insert, an entry that is further from its
+// home slot takes the place of a "richer" one, which keeps probe lengths
+// short and lets a miss stop as soon as it meets an entry closer to home
+// than itself. Deletion shifts the following entries back instead of
+// leaving tombstones. The table doubles when it is 7/8 full.
+// Pointers returned by searchByID are valid until the next insert/remove.
 class HashTable {
 private:
-    static const int TABLE_SIZE = 100;
-    HashNode* table[TABLE_SIZE];
+    struct Slot {
+        int key;
+        uint32_t record;  // index into records
+        int dist;         // distance from the home slot, -1 if empty
+    };
+    
+    vector<Slot> slots;
+    vector<Student> records;
+    size_t mask;
+    int shift;
+    
+    // Fibonacci hashing: the top bits of key * 2^32/phi
+    size_t home(int key) const {
+        return ((uint32_t)key * 2654435769u) >> shift;
+    }
+    
+    // slot index holding key, or -1
+    long findSlot(int key) const {
+        size_t i = home(key);
+        for (int d = 0; ; d++) {
+            const Slot& s = slots[i];
+            if (s.dist < d) return -1;  // empty, or would have been placed before it
+            if (s.key == key) return (long)i;
+            i = (i + 1) & mask;
+        }
+    }
+    
+    void place(int key, uint32_t record) {
+        Slot cur = {key, record, 0};
+        size_t i = home(key);
+        while (true) {
+            if (slots[i].dist < 0) {
+                slots[i] = cur;
+                return;
+            }
+            if (slots[i].dist < cur.dist) swap(slots[i], cur);
+            i = (i + 1) & mask;
+            cur.dist++;
+        }
+    }
     
-    // Hash function
-    int hashFunction(int key) {
-        return key % TABLE_SIZE;
+    void rehash(size_t capacity) {
+        slots.assign(capacity, Slot{0, 0, -1});
+        mask = capacity - 1;
+        shift = 32 - __builtin_ctzll(capacity);
+        for (size_t r = 0; r < records.size(); r++) place(records[r].studentID, r);
     }
     
 public:
     // Constructor
     HashTable() {
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            table[i] = nullptr;
-        }
+        rehash(16);
     }
     
-    // Insert student into hash table
-    void insertStudent(Student student) {
-        int index = hashFunction(student.studentID);
-        
-        HashNode* newNode = new HashNode(student);
-        
-        // If no collision
-        if (table[index] == nullptr) {
-            table[index] = newNode;
-        }
-        // Handle collision using chaining
-        else {
-            HashNode* current = table[index];
-            while (current->next != nullptr) {
-                current = current->next;
-            }
-            current->next = newNode;
+    // Insert student into hash table, duplicate IDs are rejected
+    bool insertStudent(Student student, bool quiet = false) {
+        if (findSlot(student.studentID) >= 0) {
+            if (!quiet) cout << "Student with ID " << student.studentID << " already exists!" << endl;
+            return false;
         }
-        cout << "Student inserted successfully!" << endl;
+        if ((records.size() + 1) * 8 > slots.size() * 7) rehash(slots.size() * 2);
+        records.push_back(student);
+        place(student.studentID, records.size() - 1);
+        if (!quiet) cout << "Student inserted successfully!" << endl;
+        return true;
     }
     
     // Search student by ID
     Student* searchByID(int id) {
-        int index = hashFunction(id);
-        HashNode* current = table[index];
+        long i = findSlot(id);
+        if (i < 0) return nullptr;
+        return &records[slots[i].record];
+    }
+    
+    // Remove student by ID (backward-shift deletion)
+    bool removeStudent(int id) {
+        long i = findSlot(id);
+        if (i < 0) return false;
+        uint32_t rec = slots[i].record;
+        size_t j = (i + 1) & mask;
+        while (slots[j].dist > 0) {
+            slots[i] = slots[j];
+            slots[i].dist--;
+            i = j;
+            j = (j + 1) & mask;
+        }
+        slots[i].dist = -1;
         
-        while (current != nullptr) {
-            if (current->data.studentID == id) {
-                return &(current->data);
-            }
-            current = current->next;
+        // keep records dense: the last record moves into the hole
+        uint32_t last = records.size() - 1;
+        if (rec != last) {
+            records[rec] = move(records[last]);
+            slots[findSlot(records[rec].studentID)].record = rec;
         }
-        return nullptr;
+        records.pop_back();
+        return true;
+    }
+    
+    size_t size() const { return records.size(); }
+    size_t capacity() const { return slots.size(); }
+    
+    // longest probe sequence, for the benchmark
+    int maxProbe() const {
+        int m = 0;
+        for (const Slot& s : slots) m = max(m, s.dist);
+        return m;
     }
     
     // Display all students
     void displayAll() {
         cout << "\n--- All Students in Hash Table ---" << endl;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            HashNode* current = table[i];
-            while (current != nullptr) {
-                current->data.display();
-                current = current->next;
-            }
+        for (size_t i = 0; i < records.size(); i++) {
+            records[i].display();
         }
     }
 };
 
-// Student Performance Tracker System
-class StudentPerformanceTracker {
+// Sort key for indirect sorting: the grade plus the record's position.
+// Sorting these 8-byte pairs instead of Student objects means no name or
+// course string is moved while sorting.
+struct GradeKey {
+    float grade;
+    uint32_t index;
+};
+
+// the sorting templates read the key through these
+inline float gradeOf(const Student& s) { return s.grade; }
+inline float gradeOf(const GradeKey& k) { return k.grade; }
+
+// Order-preserving map from a float to an unsigned integer for radix
+// sorting: negative numbers get every bit flipped, positive ones only the
+// sign bit. -0.0 is folded into +0.0 so the two stay equal, as they are
+// for the comparison sorts.
+inline uint32_t floatOrderKey(float f) {
+    if (f == 0.0f) f = 0.0f;
+    uint32_t u;
+    memcpy(&u, &f, sizeof u);
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+// Ascending grades, the order of every sort in the tracker. A named type
+// instead of a lambda so that smallSortRange can recognise it.
+struct GradeLess {
+    template <class T>
+    bool operator()(const T& a, const T& b) const { return gradeOf(a) < gradeOf(b); }
+};
+
+// Thread Pool
+// Fixed set of worker threads taking tasks from one shared queue. A thread
+// that waits on a TaskGroup runs queued tasks itself instead of blocking,
+// so nested fork/join cannot deadlock and a pool of one thread (no workers
+// at all) simply runs everything in the caller.
+class ThreadPool {
 private:
-    HashTable hashTable;
-    vector<Student> studentArray;
+    vector<thread> workers;
+    deque<function<void()>> tasks;
+    mutex lock;
+    condition_variable wake;
+    bool stopping;
     
-public:
-    // Add a new student record
-    void addStudentRecord() {
-        int id;
-        string name, course;
-        float grade;
-        
-        cout << "\nEnter Student ID: ";
-        cin >> id;
-        cin.ignore();
-        
-        cout << "Enter Student Name: ";
-        getline(cin, name);
-        
-        cout << "Enter Grade: ";
-        cin >> grade;
-        cin.ignore();
-        
-        cout << "Enter Course Details: ";
-        getline(cin, course);
-        
-        Student newStudent(id, name, grade, course);
-        hashTable.insertStudent(newStudent);
-        studentArray.push_back(newStudent);
+    void workerLoop() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> guard(lock);
+                wake.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                // workers take the oldest task, which is usually the largest
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
     }
     
-    // Sequential Search by name
-    void sequentialSearchByName(string name) {
-        bool found = false;
-        cout << "\n--- Sequential Search Results ---" << endl;
-        
-        for (int i = 0; i < studentArray.size(); i++) {
-            if (studentArray[i].studentName == name) {
-                studentArray[i].display();
-                found = true;
-            }
+public:
+    // threads counts the caller, so ThreadPool(4) starts 3 workers
+    explicit ThreadPool(unsigned threads) : stopping(false) {
+        for (unsigned i = 1; i < threads; i++) {
+            workers.push_back(thread(&ThreadPool::workerLoop, this));
         }
-        
-        if (!found) {
-            cout << "Student not found!" << endl;
+    }
+    
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
         }
+        wake.notify_all();
+        for (size_t i = 0; i < workers.size(); i++) workers[i].join();
     }
     
-    // Binary Search by ID (requires sorted array)
-    void binarySearchByID(int id) {
-        // First, sort by ID
-        vector<Student> sortedArray = studentArray;
-        
-        // Simple bubble sort by ID for sorting
-        for (int i = 0; i < sortedArray.size() - 1; i++) {
-            for (int j = 0; j < sortedArray.size() - i - 1; j++) {
-                if (sortedArray[j].studentID > sortedArray[j + 1].studentID) {
-                    swap(sortedArray[j], sortedArray[j + 1]);
-                }
-            }
+    unsigned threadCount() const { return workers.size() + 1; }
+    
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push_back(move(task));
         }
-        
-        // Binary search
-        int left = 0;
-        int right = sortedArray.size() - 1;
-        bool found = false;
-        
-        while (left <= right) {
-            int mid = left + (right - left) / 2;
-            
-            if (sortedArray[mid].studentID == id) {
-                cout << "\n--- Binary Search Result ---" << endl;
-                sortedArray[mid].display();
-                found = true;
-                break;
-            }
-            
-            if (sortedArray[mid].studentID < id) {
-                left = mid + 1;
-            } else {
-                right = mid - 1;
-            }
+        wake.notify_one();
+    }
+    
+    // Run the newest queued task in the calling thread; false if none
+    bool runPending() {
+        function<void()> task;
+        {
+            lock_guard<mutex> guard(lock);
+            if (tasks.empty()) return false;
+            task = move(tasks.back());
+            tasks.pop_back();
         }
-        
-        if (!found) {
-            cout << "Student not found!" << endl;
+        task();
+        return true;
+    }
+};
+
+// Tasks forked onto a pool, joined by wait()
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    atomic<int> pending;
+    
+public:
+    explicit TaskGroup(ThreadPool& p) : pool(p), pending(0) {}
+    ~TaskGroup() { wait(); }
+    
+    template <class F>
+    void run(F f) {
+        if (pool.threadCount() == 1) {
+            f();
+            return;
         }
+        pending++;
+        pool.submit([this, f] {
+            f();
+            pending--;
+        });
     }
     
-    // Bubble Sort by grades
-    void bubbleSort(vector<Student>& arr) {
-        int n = arr.size();
-        for (int i = 0; i < n - 1; i++) {
-            for (int j = 0; j < n - i - 1; j++) {
-                if (arr[j].grade > arr[j + 1].grade) {
-                    swap(arr[j], arr[j + 1]);
-                }
+    void wait() {
+        while (pending.load() > 0) {
+            if (!pool.runPending()) this_thread::yield();
+        }
+    }
+};
+
+// Pool shared by the parallel sorts, one thread per hardware thread. It is
+// made on first use, so small interactive sorts never start any threads.
+inline ThreadPool& sortPool() {
+    static ThreadPool pool(max(1u, thread::hardware_concurrency()));
+    return pool;
+}
+
+// Parallel Sorts
+// Ranges up to PARALLEL_CUTOFF elements are sorted, merged or partitioned
+// by the calling thread; larger ones are split into pool tasks. Both sorts
+// are stable, so their result does not depend on the number of threads.
+const size_t PARALLEL_CUTOFF = 1 << 14;
+
+// sortedOrder only goes parallel from this many records on
+const size_t PARALLEL_MIN_SIZE = 1 << 16;
+
+// Runs f(0) .. f(count - 1) as pool tasks and waits for all of them
+template <class F>
+void parallelFor(size_t count, F f, ThreadPool& pool) {
+    if (count == 1) {
+        f(0);
+        return;
+    }
+    TaskGroup group(pool);
+    for (size_t k = 0; k < count; k++) {
+        group.run([f, k] { f(k); });
+    }
+    group.wait();
+}
+
+// Stable insertion sort of arr[lo, hi)
+template <class T, class Less>
+void insertionSortRange(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    for (size_t i = lo + 1; i < hi; i++) {
+        T key = move(arr[i]);
+        size_t j = i;
+        while (j > lo && less(key, arr[j - 1])) {
+            arr[j] = move(arr[j - 1]);
+            j--;
+        }
+        arr[j] = move(key);
+    }
+}
+
+// Small Sorts
+// Base case of the merge, quick and radix sorts. It is insertion sort,
+// except for ranges of up to NETWORK_SORT_MAX GradeKeys in grade order
+// (GradeLess), which go through a bitonic sorting network instead. Each
+// key is packed with its position in the range into one 64-bit integer
+// (floatOrderKey(grade) above the position), so the network orders by
+// grade and keeps equal grades in their order, as insertion sort does.
+// The network is padded to a power of two and compares four keys per
+// instruction with AVX2 when the CPU has it (checked at run time, so no
+// -mavx2 is needed); otherwise the same network runs on scalars. It does
+// the same compare-exchanges on any input, without branch mispredictions.
+const size_t NETWORK_SORT_MAX = 64;
+const size_t NETWORK_SORT_MIN = 8;    // below this insertion sort is faster
+
+// branch-free: swap through the xor of the two when they are out of order
+inline void compareExchange(int64_t& a, int64_t& b) {
+    int64_t d = (a ^ b) & -(int64_t)(a > b);
+    a ^= d;
+    b ^= d;
+}
+
+// Bitonic merge step of the network over v[0, m): every block of k holds
+// two sorted halves and comes out sorted. Each element is first compared
+// with its mirror image in the other half, then the block is cleaned up
+// with strides k/4, ..., 1.
+inline void bitonicMergeScalar(int64_t* v, size_t m, size_t k) {
+    for (size_t b = 0; b < m; b += k) {
+        for (size_t i = 0; i < k / 2; i++) compareExchange(v[b + i], v[b + k - 1 - i]);
+    }
+    for (size_t j = k / 4; j > 0; j /= 2) {
+        for (size_t i = 0; i < m; i++) {
+            if ((i & j) == 0) compareExchange(v[i], v[i + j]);
+        }
+    }
+}
+
+// v[0, m) in ascending order, m a power of two
+inline void bitonicSortScalar(int64_t* v, size_t m) {
+    for (size_t k = 2; k <= m; k *= 2) bitonicMergeScalar(v, m, k);
+}
+
+#if SORT_NETWORK_AVX2
+// The same network with four 64-bit keys per register. Strides of four or
+// more compare whole registers; the steps inside a register compare it
+// with a lane permutation of itself and blend the minima and maxima.
+__attribute__((target("avx2")))
+inline void minMax(__m256i& a, __m256i& b) {
+    __m256i greater = _mm256_cmpgt_epi64(a, b);
+    __m256i lo = _mm256_blendv_epi8(a, b, greater);
+    b = _mm256_blendv_epi8(b, a, greater);
+    a = lo;
+}
+
+// lane i against lane PERM[i]; lanes in BLEND (as 32-bit halves) take the max
+template <int PERM, int BLEND>
+__attribute__((target("avx2")))
+inline void inRegisterStep(int64_t* v, size_t m) {
+    for (size_t i = 0; i < m; i += 4) {
+        __m256i x = _mm256_load_si256((const __m256i*)(v + i));
+        __m256i y = _mm256_permute4x64_epi64(x, PERM);
+        __m256i lo = x, hi = y;
+        minMax(lo, hi);
+        _mm256_store_si256((__m256i*)(v + i), _mm256_blend_epi32(lo, hi, BLEND));
+    }
+}
+
+__attribute__((target("avx2")))
+inline void bitonicMergeAVX2(int64_t* v, size_t m, size_t k) {
+    if (k == 2) {
+        inRegisterStep<0xB1, 0xCC>(v, m);  // lanes 0-1, 2-3
+    } else if (k == 4) {
+        inRegisterStep<0x1B, 0xF0>(v, m);  // lanes 0-3, 1-2
+    } else {
+        for (size_t b = 0; b < m; b += k) {
+            for (size_t i = 0; i < k / 2; i += 4) {
+                __m256i x = _mm256_load_si256((const __m256i*)(v + b + i));
+                __m256i y = _mm256_load_si256((const __m256i*)(v + b + k - 4 - i));
+                y = _mm256_permute4x64_epi64(y, 0x1B);  // mirror image
+                minMax(x, y);
+                _mm256_store_si256((__m256i*)(v + b + i), x);
+                _mm256_store_si256((__m256i*)(v + b + k - 4 - i), _mm256_permute4x64_epi64(y, 0x1B));
             }
         }
     }
+    for (size_t j = k / 4; j >= 4; j /= 2) {
+        for (size_t i = 0; i < m; i += 4) {
+            if ((i & j) != 0) continue;
+            __m256i x = _mm256_load_si256((const __m256i*)(v + i));
+            __m256i y = _mm256_load_si256((const __m256i*)(v + i + j));
+            minMax(x, y);
+            _mm256_store_si256((__m256i*)(v + i), x);
+            _mm256_store_si256((__m256i*)(v + i + j), y);
+        }
+    }
+    if (k >= 8) inRegisterStep<0x4E, 0xF0>(v, m);  // stride 2
+    if (k >= 4) inRegisterStep<0xB1, 0xCC>(v, m);  // stride 1
+}
+
+__attribute__((target("avx2")))
+inline void bitonicSortAVX2(int64_t* v, size_t m) {
+    for (size_t k = 2; k <= m; k *= 2) bitonicMergeAVX2(v, m, k);
+}
+
+inline bool cpuHasAVX2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#else
+inline bool cpuHasAVX2() { return false; }
+#endif
+
+// Stable sort of a[0, n) by grade, n <= NETWORK_SORT_MAX
+inline void networkSortGradeKeys(GradeKey* a, size_t n, bool avx2) {
+    alignas(32) int64_t v[NETWORK_SORT_MAX];
+    GradeKey copy[NETWORK_SORT_MAX];
+    size_t m = 4;
+    while (m < n) m *= 2;
+    for (size_t i = 0; i < n; i++) {
+        copy[i] = a[i];
+        v[i] = (int64_t)((uint64_t)(floatOrderKey(a[i].grade) ^ 0x80000000u) << 32 | i);
+    }
+    for (size_t i = n; i < m; i++) v[i] = INT64_MAX;  // padding sorts last
+#if SORT_NETWORK_AVX2
+    if (avx2) {
+        bitonicSortAVX2(v, m);
+    } else {
+        bitonicSortScalar(v, m);
+    }
+#else
+    bitonicSortScalar(v, m);
+#endif
+    for (size_t i = 0; i < n; i++) a[i] = copy[(uint32_t)v[i]];
+}
+
+template <class T, class Less>
+void smallSortRange(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    insertionSortRange(arr, lo, hi, less);
+}
+
+inline void smallSortRange(vector<GradeKey>& arr, size_t lo, size_t hi, GradeLess less) {
+    if (hi - lo < NETWORK_SORT_MIN || hi - lo > NETWORK_SORT_MAX || !cpuHasAVX2()) {
+        insertionSortRange(arr, lo, hi, less);
+    } else {
+        networkSortGradeKeys(&arr[lo], hi - lo, true);
+    }
+}
+
+// Stable merge of a[0, na) and b[0, nb) into out, moving the elements; on
+// ties the element from a goes first
+template <class T, class Less>
+void mergeRuns(T* a, size_t na, T* b, size_t nb, T* out, Less less) {
+    T* endA = a + na;
+    T* endB = b + nb;
+    while (a < endA && b < endB) {
+        if (less(*b, *a)) *out++ = move(*b++);
+        else *out++ = move(*a++);
+    }
+    out = move(a, endA, out);
+    move(b, endB, out);
+}
+
+// mergeRuns in parallel: a large merge is cut at the middle of the longer
+// run and the matching position in the other run (binary search), and the
+// two halves are merged at the same time
+template <class T, class Less>
+void parallelMerge(T* a, size_t na, T* b, size_t nb, T* out, Less less, ThreadPool& pool) {
+    if (na + nb <= PARALLEL_CUTOFF) {
+        mergeRuns(a, na, b, nb, out, less);
+        return;
+    }
+    size_t cutA, cutB;
+    if (na >= nb) {
+        cutA = na / 2;
+        cutB = lower_bound(b, b + nb, a[cutA], less) - b;
+    } else {
+        cutB = nb / 2;
+        cutA = upper_bound(a, a + na, b[cutB], less) - a;
+    }
+    TaskGroup group(pool);
+    group.run([=, &pool] { parallelMerge(a, cutA, b, cutB, out, less, pool); });
+    parallelMerge(a + cutA, na - cutA, b + cutB, nb - cutB, out + cutA + cutB, less, pool);
+    group.wait();
+}
+
+// Merge sort of arr[lo, hi) with buf as scratch. The halves are sorted into
+// the array the result is not wanted in, so each level merges once and
+// nothing is copied back.
+template <class T, class Less>
+void parallelMergeSortRange(vector<T>& arr, vector<T>& buf, size_t lo, size_t hi,
+                            bool toBuf, Less less, ThreadPool& pool) {
+    if (hi - lo <= 32) {
+        smallSortRange(arr, lo, hi, less);
+        if (toBuf) move(arr.begin() + lo, arr.begin() + hi, buf.begin() + lo);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    if (hi - lo > PARALLEL_CUTOFF) {
+        TaskGroup group(pool);
+        group.run([&, lo, mid] { parallelMergeSortRange(arr, buf, lo, mid, !toBuf, less, pool); });
+        parallelMergeSortRange(arr, buf, mid, hi, !toBuf, less, pool);
+        group.wait();
+    } else {
+        parallelMergeSortRange(arr, buf, lo, mid, !toBuf, less, pool);
+        parallelMergeSortRange(arr, buf, mid, hi, !toBuf, less, pool);
+    }
+    T* src = toBuf ? arr.data() : buf.data();
+    T* dst = toBuf ? buf.data() : arr.data();
+    parallelMerge(src + lo, mid - lo, src + mid, hi - mid, dst + lo, less, pool);
+}
+
+template <class T, class Less>
+void parallelMergeSortBy(vector<T>& arr, Less less, ThreadPool& pool) {
+    if (arr.size() < 2) return;
+    vector<T> buf(arr.size());
+    parallelMergeSortRange(arr, buf, 0, arr.size(), false, less, pool);
+}
+
+template <class T, class Less>
+const T& medianOfThree(const T& a, const T& b, const T& c, Less less) {
+    if (less(b, a)) return less(c, b) ? b : (less(c, a) ? c : a);
+    return less(c, a) ? a : (less(c, b) ? c : b);
+}
+
+// Stable three-way partition of arr[lo, hi) around pivot, through buf. The
+// range is cut into blocks; every block counts its elements below, equal
+// to and above the pivot, a prefix sum over the counts gives each block its
+// output positions, then the blocks scatter into buf and copy back, each
+// step in parallel. Returns the bounds of the part equal to the pivot.
+template <class T, class Less>
+pair<size_t, size_t> stablePartition(vector<T>& arr, vector<T>& buf, size_t lo, size_t hi,
+                                     const T& pivot, Less less, ThreadPool& pool) {
+    size_t n = hi - lo;
+    size_t blocks = 1;
+    if (n > PARALLEL_CUTOFF) blocks = min<size_t>(pool.threadCount() * 4, n / PARALLEL_CUTOFF);
+    size_t blockSize = (n + blocks - 1) / blocks;
+    vector<size_t> below(blocks, 0), equal(blocks, 0), above(blocks, 0);
     
-    // Insertion Sort by grades
-    void insertionSort(vector<Student>& arr) {
-        int n = arr.size();
-        for (int i = 1; i < n; i++) {
-            Student key = arr[i];
-            int j = i - 1;
-            
-            while (j >= 0 && arr[j].grade > key.grade) {
-                arr[j + 1] = arr[j];
-                j--;
-            }
-            arr[j + 1] = key;
+    parallelFor(blocks, [&](size_t k) {
+        size_t end = min(hi, lo + (k + 1) * blockSize);
+        for (size_t i = lo + k * blockSize; i < end; i++) {
+            if (less(arr[i], pivot)) below[k]++;
+            else if (less(pivot, arr[i])) above[k]++;
+            else equal[k]++;
         }
+    }, pool);
+    
+    // counts -> first output position of each block in each part
+    size_t nextBelow = lo, nextEqual = lo, nextAbove = lo;
+    for (size_t k = 0; k < blocks; k++) nextEqual += below[k];
+    nextAbove = nextEqual;
+    for (size_t k = 0; k < blocks; k++) nextAbove += equal[k];
+    pair<size_t, size_t> equalPart(nextEqual, nextAbove);
+    for (size_t k = 0; k < blocks; k++) {
+        size_t b = below[k], e = equal[k], a = above[k];
+        below[k] = nextBelow;
+        equal[k] = nextEqual;
+        above[k] = nextAbove;
+        nextBelow += b;
+        nextEqual += e;
+        nextAbove += a;
     }
     
-    // Merge Sort helper function
-    void merge(vector<Student>& arr, int left, int mid, int right) {
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
-        
-        vector<Student> leftArr(n1), rightArr(n2);
-        
-        for (int i = 0; i < n1; i++)
-            leftArr[i] = arr[left + i];
-        for (int j = 0; j < n2; j++)
-            rightArr[j] = arr[mid + 1 + j];
-        
-        int i = 0, j = 0, k = left;
+    parallelFor(blocks, [&](size_t k) {
+        size_t b = below[k], e = equal[k], a = above[k];
+        size_t end = min(hi, lo + (k + 1) * blockSize);
+        for (size_t i = lo + k * blockSize; i < end; i++) {
+            if (less(arr[i], pivot)) buf[b++] = move(arr[i]);
+            else if (less(pivot, arr[i])) buf[a++] = move(arr[i]);
+            else buf[e++] = move(arr[i]);
+        }
+    }, pool);
+    parallelFor(blocks, [&](size_t k) {
+        size_t begin = lo + k * blockSize, end = min(hi, begin + blockSize);
+        if (begin < end) move(buf.begin() + begin, buf.begin() + end, arr.begin() + begin);
+    }, pool);
+    return equalPart;
+}
+
+// Quicksort of arr[lo, hi) on the stable partition above. The smaller side
+// is sorted by recursion (as a pool task when it is large) and the loop
+// continues on the larger one, so the stack stays O(log n) deep.
+template <class T, class Less>
+void parallelQuickSortRange(vector<T>& arr, vector<T>& buf, size_t lo, size_t hi,
+                            Less less, ThreadPool& pool) {
+    TaskGroup group(pool);
+    while (hi - lo > 32) {
+        T pivot = medianOfThree(arr[lo], arr[lo + (hi - lo) / 2], arr[hi - 1], less);
+        pair<size_t, size_t> equalPart = stablePartition(arr, buf, lo, hi, pivot, less, pool);
+        size_t smallLo = lo, smallHi = equalPart.first;
+        size_t bigLo = equalPart.second, bigHi = hi;
+        if (smallHi - smallLo > bigHi - bigLo) {
+            swap(smallLo, bigLo);
+            swap(smallHi, bigHi);
+        }
+        if (smallHi - smallLo > PARALLEL_CUTOFF) {
+            vector<T>* a = &arr;
+            vector<T>* b = &buf;
+            ThreadPool* p = &pool;
+            group.run([=] { parallelQuickSortRange(*a, *b, smallLo, smallHi, less, *p); });
+        } else {
+            parallelQuickSortRange(arr, buf, smallLo, smallHi, less, pool);
+        }
+        lo = bigLo;
+        hi = bigHi;
+    }
+    smallSortRange(arr, lo, hi, less);
+    group.wait();
+}
+
+template <class T, class Less>
+void parallelQuickSortBy(vector<T>& arr, Less less, ThreadPool& pool) {
+    if (arr.size() < 2) return;
+    vector<T> buf(arr.size());
+    parallelQuickSortRange(arr, buf, 0, arr.size(), less, pool);
+}
+
+// Introsort
+// Quicksort that cannot go quadratic: ninther pivots (median of three
+// medians of three) on large ranges, median-of-3 on smaller ones,
+// smallSortRange below INSERTION_SORT_MAX elements, and heap sort for any
+// range still unsorted once the recursion is 2*log2(n) levels deep. Two
+// pdqsort ideas make the usual bad inputs cheap: a partition that swapped
+// nothing (sorted input) is followed by insertion sorts that give up after
+// 8 moves, and a pivot equal to the element just before the range (many
+// duplicates) puts all its equals left of it in one pass, after which they
+// are done. Recursion goes into the smaller side only.
+// The cutoff is the same for every key type, so a GradeKey array and the
+// records it stands for are partitioned alike and end in the same order.
+const size_t INSERTION_SORT_MAX = 24;
+const size_t NINTHER_MIN = 128;
+
+inline int floorLog2(size_t n) {
+    int log = 0;
+    while (n >>= 1) log++;
+    return log;
+}
+
+// Order arr[a], arr[b], arr[c] so that arr[b] holds the median
+template <class T, class Less>
+void sortThree(vector<T>& arr, size_t a, size_t b, size_t c, Less less) {
+    if (less(arr[b], arr[a])) swap(arr[a], arr[b]);
+    if (less(arr[c], arr[b])) swap(arr[b], arr[c]);
+    if (less(arr[b], arr[a])) swap(arr[a], arr[b]);
+}
+
+template <class T, class Less>
+void siftDownRange(vector<T>& arr, size_t lo, size_t n, size_t i, Less less) {
+    T value = move(arr[lo + i]);
+    while (2 * i + 1 < n) {
+        size_t child = 2 * i + 1;
+        if (child + 1 < n && less(arr[lo + child], arr[lo + child + 1])) child++;
+        if (!less(value, arr[lo + child])) break;
+        arr[lo + i] = move(arr[lo + child]);
+        i = child;
+    }
+    arr[lo + i] = move(value);
+}
+
+template <class T, class Less>
+void heapSortRange(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    size_t n = hi - lo;
+    for (size_t i = n / 2; i-- > 0;) siftDownRange(arr, lo, n, i, less);
+    for (size_t end = n; end-- > 1;) {
+        swap(arr[lo], arr[lo + end]);
+        siftDownRange(arr, lo, end, 0, less);
+    }
+}
+
+// Insertion sort of arr[lo, hi) that gives up after 8 element moves;
+// true if the range is now sorted
+template <class T, class Less>
+bool partialInsertionSort(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    size_t moves = 0;
+    for (size_t i = lo + 1; i < hi; i++) {
+        if (!less(arr[i], arr[i - 1])) continue;
+        T key = move(arr[i]);
+        size_t j = i;
+        do {
+            arr[j] = move(arr[j - 1]);
+            j--;
+        } while (j > lo && less(key, arr[j - 1]));
+        arr[j] = move(key);
+        moves += i - j;
+        if (moves > 8) return false;
+    }
+    return true;
+}
+
+// Partition arr[lo, hi) around the pivot at arr[lo]: smaller elements to
+// its left, the rest to its right. The pivot choice leaves an element not
+// smaller than the pivot at the end, which stops the first scan. Returns
+// the pivot's final position and whether no swap was needed.
+template <class T, class Less>
+pair<size_t, bool> partitionRight(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    T pivot = arr[lo];
+    size_t first = lo, last = hi;
+    while (less(arr[++first], pivot)) {}
+    if (first - 1 == lo) {
+        while (first < last && !less(arr[--last], pivot)) {}
+    } else {
+        while (!less(arr[--last], pivot)) {}
+    }
+    bool noSwaps = first >= last;
+    while (first < last) {
+        swap(arr[first], arr[last]);
+        while (less(arr[++first], pivot)) {}
+        while (!less(arr[--last], pivot)) {}
+    }
+    size_t pivotPos = first - 1;
+    arr[lo] = move(arr[pivotPos]);
+    arr[pivotPos] = move(pivot);
+    return make_pair(pivotPos, noSwaps);
+}
+
+// Partition arr[lo, hi) around the pivot at arr[lo] when nothing in the
+// range is smaller than it: equal elements go left of the pivot, larger
+// ones right. Returns the pivot's final position.
+template <class T, class Less>
+size_t partitionLeft(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    T pivot = arr[lo];
+    size_t first = lo, last = hi;
+    while (less(pivot, arr[--last])) {}
+    if (last + 1 == hi) {
+        while (first < last && !less(pivot, arr[++first])) {}
+    } else {
+        while (!less(pivot, arr[++first])) {}
+    }
+    while (first < last) {
+        swap(arr[first], arr[last]);
+        while (less(pivot, arr[--last])) {}
+        while (!less(pivot, arr[++first])) {}
+    }
+    arr[lo] = move(arr[last]);
+    arr[last] = move(pivot);
+    return last;
+}
+
+// leftmost: arr[lo - 1] is not part of the sort (or does not exist)
+template <class T, class Less>
+void introSortLoop(vector<T>& arr, size_t lo, size_t hi, int depthLimit, Less less, bool leftmost) {
+    while (true) {
+        size_t n = hi - lo;
+        if (n < INSERTION_SORT_MAX) {
+            smallSortRange(arr, lo, hi, less);
+            return;
+        }
+        if (depthLimit == 0) {
+            heapSortRange(arr, lo, hi, less);
+            return;
+        }
+        depthLimit--;
         
-        while (i < n1 && j < n2) {
-            if (leftArr[i].grade <= rightArr[j].grade) {
-                arr[k] = leftArr[i];
-                i++;
-            } else {
-                arr[k] = rightArr[j];
-                j++;
-            }
-            k++;
+        size_t mid = lo + n / 2;
+        if (n > NINTHER_MIN) {
+            sortThree(arr, lo, mid, hi - 1, less);
+            sortThree(arr, lo + 1, mid - 1, hi - 2, less);
+            sortThree(arr, lo + 2, mid + 1, hi - 3, less);
+            sortThree(arr, mid - 1, mid, mid + 1, less);
+            swap(arr[lo], arr[mid]);
+        } else {
+            sortThree(arr, mid, lo, hi - 1, less);
         }
         
-        while (i < n1) {
-            arr[k] = leftArr[i];
-            i++;
-            k++;
+        // the element before the range is <= all of it; if it equals the
+        // pivot nothing here is smaller, so only split off the equal ones
+        if (!leftmost && !less(arr[lo - 1], arr[lo])) {
+            lo = partitionLeft(arr, lo, hi, less) + 1;
+            continue;
         }
         
-        while (j < n2) {
-            arr[k] = rightArr[j];
-            j++;
-            k++;
+        pair<size_t, bool> split = partitionRight(arr, lo, hi, less);
+        size_t p = split.first;
+        if (split.second && partialInsertionSort(arr, lo, p, less)
+            && partialInsertionSort(arr, p + 1, hi, less)) {
+            return;
+        }
+        if (p - lo < hi - p) {
+            introSortLoop(arr, lo, p, depthLimit, less, leftmost);
+            lo = p + 1;
+            leftmost = false;
+        } else {
+            introSortLoop(arr, p + 1, hi, depthLimit, less, false);
+            hi = p;
         }
     }
+}
+
+template <class T, class Less>
+void introSortBy(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    if (hi - lo < 2) return;
+    introSortLoop(arr, lo, hi, 2 * floorLog2(hi - lo), less, true);
+}
+
+// Natural Merge Sort
+// Bottom-up merge sort in the style of a simplified TimSort. The range is
+// cut into the runs already present in the data (a strictly descending run
+// is reversed, which keeps the sort stable), runs shorter than MIN_RUN are
+// extended with insertion sort, and neighbouring runs are then merged pass
+// by pass, back and forth between the array and one scratch buffer made up
+// front. Elements are only moved, never copied. Sorted or reversed input
+// is a single run and costs O(n).
+const size_t MIN_RUN = 32;
+
+template <class T, class Less>
+void naturalMergeSortBy(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    size_t n = hi - lo;
+    if (n < 2) return;
     
-    // Merge Sort by grades
-    void mergeSort(vector<Student>& arr, int left, int right) {
-        if (left < right) {
-            int mid = left + (right - left) / 2;
-            
-            mergeSort(arr, left, mid);
-            mergeSort(arr, mid + 1, right);
-            merge(arr, left, mid, right);
+    // run k is [runs[k], runs[k + 1]), offsets from lo
+    vector<size_t> runs;
+    runs.reserve(n / MIN_RUN + 2);
+    runs.push_back(0);
+    T* data = &arr[lo];
+    size_t start = 0;
+    while (start < n) {
+        size_t end = start + 1;
+        if (end < n && less(data[end], data[start])) {
+            while (end + 1 < n && less(data[end + 1], data[end])) end++;
+            end++;
+            reverse(data + start, data + end);
+        } else {
+            while (end < n && !less(data[end], data[end - 1])) end++;
         }
+        if (end - start < MIN_RUN) {
+            end = min(n, start + MIN_RUN);
+            smallSortRange(arr, lo + start, lo + end, less);
+        }
+        runs.push_back(end);
+        start = end;
     }
+    if (runs.size() == 2) return;
     
-    // Quick Sort partition
-    int partition(vector<Student>& arr, int low, int high) {
-        float pivot = arr[high].grade;
-        int i = low - 1;
-        
-        for (int j = low; j < high; j++) {
-            if (arr[j].grade < pivot) {
-                i++;
-                swap(arr[i], arr[j]);
+    vector<T> buffer(n);
+    T* src = data;
+    T* dst = buffer.data();
+    while (runs.size() > 2) {
+        size_t kept = 1;
+        for (size_t k = 0; k + 1 < runs.size(); k += 2) {
+            size_t a = runs[k], mid = runs[k + 1];
+            if (k + 2 < runs.size()) {
+                size_t b = runs[k + 2];
+                mergeRuns(src + a, mid - a, src + mid, b - mid, dst + a, less);
+                runs[kept++] = b;
+            } else {
+                move(src + a, src + mid, dst + a);
+                runs[kept++] = mid;
             }
         }
-        swap(arr[i + 1], arr[high]);
-        return i + 1;
+        runs.resize(kept);
+        swap(src, dst);
     }
+    if (src != data) move(src, src + n, data);
+}
+
+// Name Index
+// Three views over the distinct student names, each name stored once:
+//   exact  - hash map on the name as entered (same matching as ==)
+//   prefix - name ids sorted by lower-case name, binary search then scan
+//   fuzzy  - trigram posting lists; a name within edit distance k of the
+//            query keeps at least (distinct query trigrams - 3k) of them,
+//            so only names passing that count are checked with a banded
+//            edit distance. Short queries, where the bound says nothing,
+//            fall back to names of similar length.
+// Queries return record handles (whatever the caller passed to add), never
+// copies of the records.
+class NameIndex {
+private:
+    vector<string> names;                // distinct names as entered
+    vector<string> folded;               // lower-case, for prefix and fuzzy
+    vector<vector<int>> handles;         // per name id
+    unordered_map<string, uint32_t> byName;
+    unordered_map<uint32_t, vector<uint32_t>> postings;  // trigram -> name ids
+    vector<vector<uint32_t>> byLength;   // folded length -> name ids
+    vector<uint32_t> sortedIds;          // by folded name, rebuilt lazily
+    size_t sortedUpTo;                   // names covered by sortedIds
+    vector<uint16_t> hits;               // per name id, scratch for fuzzy
     
-    // Quick Sort by grades
-    void quickSort(vector<Student>& arr, int low, int high) {
-        if (low < high) {
-            int pi = partition(arr, low, high);
-            
-            quickSort(arr, low, pi - 1);
-            quickSort(arr, pi + 1, high);
+    static string fold(const string& s) {
+        string f = s;
+        for (char& c : f) c = tolower((unsigned char)c);
+        return f;
+    }
+    
+    // distinct trigrams of "$$" + s + "$$"
+    static vector<uint32_t> trigrams(const string& s) {
+        string p = "$$" + s + "$$";
+        vector<uint32_t> g;
+        for (size_t i = 0; i + 3 <= p.size(); i++) {
+            g.push_back((uint32_t)(unsigned char)p[i] << 16 | (uint32_t)(unsigned char)p[i + 1] << 8
+                        | (unsigned char)p[i + 2]);
         }
+        sort(g.begin(), g.end());
+        g.erase(unique(g.begin(), g.end()), g.end());
+        return g;
     }
     
-    // Heapify for heap sort
-    void heapify(vector<Student>& arr, int n, int i) {
-        int largest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
-        
-        if (left < n && arr[left].grade > arr[largest].grade)
-            largest = left;
-        
-        if (right < n && arr[right].grade > arr[largest].grade)
-            largest = right;
-        
-        if (largest != i) {
-            swap(arr[i], arr[largest]);
-            heapify(arr, n, largest);
+    // Levenshtein distance if it is <= k, otherwise k + 1
+    static int boundedDistance(const string& a, const string& b, int k) {
+        int n = a.size(), m = b.size();
+        if (abs(n - m) > k) return k + 1;
+        vector<int> prev(m + 1), cur(m + 1);
+        for (int j = 0; j <= m; j++) prev[j] = j;
+        for (int i = 1; i <= n; i++) {
+            cur[0] = i;
+            int rowMin = cur[0];
+            for (int j = 1; j <= m; j++) {
+                int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+                cur[j] = min(min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+                rowMin = min(rowMin, cur[j]);
+            }
+            if (rowMin > k) return k + 1;
+            swap(prev, cur);
         }
+        return min(prev[m], k + 1);
     }
     
-    // Heap Sort by grades (for ranking)
-    void heapSort(vector<Student>& arr) {
-        int n = arr.size();
-        
-        // Build heap
-        for (int i = n / 2 - 1; i >= 0; i--)
-            heapify(arr, n, i);
-        
-        // Extract elements from heap
-        for (int i = n - 1; i > 0; i--) {
-            swap(arr[0], arr[i]);
-            heapify(arr, i, 0);
-        }
+    void sortNames() {
+        if (sortedUpTo == names.size()) return;
+        size_t mid = sortedIds.size();
+        for (size_t id = sortedUpTo; id < names.size(); id++) sortedIds.push_back(id);
+        auto less = [this](uint32_t x, uint32_t y) { return folded[x] < folded[y]; };
+        sort(sortedIds.begin() + mid, sortedIds.end(), less);
+        inplace_merge(sortedIds.begin(), sortedIds.begin() + mid, sortedIds.end(), less);
+        sortedUpTo = names.size();
     }
     
-    // Sort by grades using selected algorithm
-    void sortByGrades(int choice) {
-        if (studentArray.empty()) {
-            cout << "No students to sort!" << endl;
+public:
+    NameIndex() {
+        sortedUpTo = 0;
+    }
+    
+    void add(const string& name, int handle) {
+        auto it = byName.find(name);
+        if (it != byName.end()) {
+            handles[it->second].push_back(handle);
             return;
         }
-        
-        vector<Student> sortedArray = studentArray;
-        
-        auto start = chrono::high_resolution_clock::now();
-        
-        switch (choice) {
-            case 1:
-                bubbleSort(sortedArray);
-                cout << "Sorted using Bubble Sort" << endl;
-                break;
-            case 2:
-                insertionSort(sortedArray);
-                cout << "Sorted using Insertion Sort" << endl;
-                break;
-            case 3:
-                mergeSort(sortedArray, 0, sortedArray.size() - 1);
-                cout << "Sorted using Merge Sort" << endl;
-                break;
-            case 4:
-                quickSort(sortedArray, 0, sortedArray.size() - 1);
-                cout << "Sorted using Quick Sort" << endl;
-                break;
-            case 5:
-                heapSort(sortedArray);
-                cout << "Sorted using Heap Sort" << endl;
-                break;
+        uint32_t id = names.size();
+        byName[name] = id;
+        names.push_back(name);
+        folded.push_back(fold(name));
+        handles.push_back({handle});
+        hits.push_back(0);
+        for (uint32_t g : trigrams(folded[id])) postings[g].push_back(id);
+        size_t len = folded[id].size();
+        if (byLength.size() <= len) byLength.resize(len + 1);
+        byLength[len].push_back(id);
+    }
+    
+    // the name itself stays indexed; it just stops matching once it has no handles
+    void remove(const string& name, int handle) {
+        auto it = byName.find(name);
+        if (it == byName.end()) return;
+        vector<int>& h = handles[it->second];
+        h.erase(std::remove(h.begin(), h.end(), handle), h.end());
+    }
+    
+    vector<int> exact(const string& name) {
+        auto it = byName.find(name);
+        if (it == byName.end()) return {};
+        return handles[it->second];
+    }
+    
+    // case-insensitive, in name order, at most limit handles
+    vector<int> prefix(const string& p, size_t limit) {
+        sortNames();
+        string fp = fold(p);
+        vector<int> out;
+        auto it = lower_bound(sortedIds.begin(), sortedIds.end(), fp,
+                              [this](uint32_t id, const string& key) { return folded[id] < key; });
+        for (; it != sortedIds.end() && out.size() < limit; ++it) {
+            if (folded[*it].compare(0, fp.size(), fp) != 0) break;
+            for (int h : handles[*it]) {
+                if (out.size() == limit) break;
+                out.push_back(h);
+            }
         }
-        
-        auto end = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        
-        cout << "\n--- Sorted Students by Grade ---" << endl;
-        for (int i = 0; i < sortedArray.size(); i++) {
-            sortedArray[i].display();
+        return out;
+    }
+    
+    // (handle, edit distance) for names within maxDist of query
+    // (case-insensitive), closest first, at most limit entries
+    vector<pair<int, int>> fuzzy(const string& query, int maxDist, size_t limit) {
+        string fq = fold(query);
+        vector<uint32_t> grams = trigrams(fq);
+        int need = (int)grams.size() - 3 * maxDist;
+        vector<uint32_t> candidates;
+        if (need > 0) {
+            for (uint32_t g : grams) {
+                auto it = postings.find(g);
+                if (it == postings.end()) continue;
+                for (uint32_t id : it->second) {
+                    if (++hits[id] == need) candidates.push_back(id);
+                }
+            }
+            for (uint32_t g : grams) {
+                auto it = postings.find(g);
+                if (it == postings.end()) continue;
+                for (uint32_t id : it->second) hits[id] = 0;
+            }
+        } else {
+            int lo = max(0, (int)fq.size() - maxDist), hi = fq.size() + maxDist;
+            for (int len = lo; len <= hi && len < (int)byLength.size(); len++) {
+                candidates.insert(candidates.end(), byLength[len].begin(), byLength[len].end());
+            }
         }
         
-        cout << "\nTime taken: " << duration.count() << " microseconds" << endl;
+        vector<pair<int, uint32_t>> matches;  // (distance, name id)
+        for (uint32_t id : candidates) {
+            if (handles[id].empty()) continue;
+            int d = boundedDistance(fq, folded[id], maxDist);
+            if (d <= maxDist) matches.push_back({d, id});
+        }
+        sort(matches.begin(), matches.end(), [this](const pair<int, uint32_t>& x, const pair<int, uint32_t>& y) {
+            if (x.first != y.first) return x.first < y.first;
+            return folded[x.second] < folded[y.second];
+        });
+        vector<pair<int, int>> out;
+        for (auto& m : matches) {
+            for (int h : handles[m.second]) {
+                if (out.size() == limit) return out;
+                out.push_back({h, m.first});
+            }
+        }
+        return out;
     }
     
-    // Rank students by performance using heap sort
-    void rankByPerformance() {
-        if (studentArray.empty()) {
-            cout << "No students to rank!" << endl;
-            return;
+    size_t distinctNames() const { return names.size(); }
+};
+
+// Sorted ID Index
+// IDs with their position in studentArray, kept in Eytzinger (BFS) order:
+// the root at 1 and the children of k at 2k and 2k+1, so the first levels
+// of every search share a few cache lines. The search loop has no
+// unpredictable branch (the comparison result is added to the index) and
+// prefetches the line four levels down. New IDs are collected and merged
+// into the sorted order on the next query, which then rebuilds the layout
+// in O(n); queries without new IDs in between cost O(log n).
+class SortedIDIndex {
+private:
+    vector<pair<int, uint32_t>> sorted;   // (id, record), ascending
+    vector<pair<int, uint32_t>> pending;  // added since the last rebuild
+    vector<int> keys;                     // Eytzinger order, 1-based
+    vector<uint32_t> records;             // same layout as keys
+    
+    // in-order walk of the implicit tree fills it from the sorted array
+    size_t fill(size_t i, size_t k) {
+        if (k < keys.size()) {
+            i = fill(i, 2 * k);
+            keys[k] = sorted[i].first;
+            records[k] = sorted[i].second;
+            i++;
+            i = fill(i, 2 * k + 1);
         }
-        
-        vector<Student> rankedArray = studentArray;
-        heapSort(rankedArray);
-        
-        cout << "\n--- Student Rankings (Highest to Lowest) ---" << endl;
-        for (int i = rankedArray.size() - 1; i >= 0; i--) {
-            cout << "Rank " << (rankedArray.size() - i) << ": ";
-            rankedArray[i].display();
+        return i;
+    }
+    
+    void rebuild() {
+        sort(pending.begin(), pending.end());
+        size_t mid = sorted.size();
+        sorted.insert(sorted.end(), pending.begin(), pending.end());
+        inplace_merge(sorted.begin(), sorted.begin() + mid, sorted.end());
+        pending.clear();
+        keys.assign(sorted.size() + 1, 0);
+        records.assign(sorted.size() + 1, 0);
+        fill(0, 1);
+    }
+    
+public:
+    void add(int id, uint32_t record) {
+        pending.push_back({id, record});
+    }
+    
+    size_t size() const { return sorted.size() + pending.size(); }
+    
+    // record index for id, or -1
+    long find(int id) {
+        if (!pending.empty()) rebuild();
+        if (keys.size() < 2) return -1;
+        size_t n = keys.size() - 1;
+        const int* key = keys.data();
+        size_t k = 1;
+        while (k <= n) {
+            __builtin_prefetch(key + 16 * k);  // 16 ints = one cache line, 4 levels down
+            k = 2 * k + (key[k] < id);
         }
+        k >>= __builtin_ffsll(~k);  // undo the right turns taken after the answer
+        if (k == 0 || key[k] != id) return -1;
+        return records[k];
+    }
+};
+
+// Grade Rank Index
+// Order-statistic tree over (grade, record), best first: higher grade, then
+// lower record index. It is a treap whose nodes also keep the size of their
+// subtree, so the rank of a grade and the k-th best record are single
+// O(log n) walks from the root, and a grade change is an erase and an
+// insert, O(log n) expected. Nodes live in one vector and link by index;
+// index 0 is the empty tree and erased nodes are reused.
+class GradeRankIndex {
+private:
+    struct Node {
+        float grade;
+        uint32_t record;
+        uint32_t priority;  // random, max-heap ordered
+        uint32_t size;      // nodes in this subtree
+        uint32_t left, right;
+    };
+    
+    vector<Node> nodes;
+    vector<uint32_t> freeNodes;
+    uint32_t root;
+    mt19937 rng;
+    
+    // node t ranks before (grade, record)
+    bool before(uint32_t t, float grade, uint32_t record) const {
+        return nodes[t].grade > grade || (nodes[t].grade == grade && nodes[t].record < record);
     }
     
-    // Compare sorting algorithms complexity
-    void compareSortingComplexity() {
-        if (studentArray.size() < 2) {
-            cout << "Need at least 2 students to compare sorting algorithms!" << endl;
-            return;
+    void pull(uint32_t t) {
+        nodes[t].size = 1 + nodes[nodes[t].left].size + nodes[nodes[t].right].size;
+    }
+    
+    // split t into the nodes ranking before (grade, record) and the rest
+    void split(uint32_t t, float grade, uint32_t record, uint32_t& lo, uint32_t& hi) {
+        if (t == 0) {
+            lo = hi = 0;
+        } else if (before(t, grade, record)) {
+            split(nodes[t].right, grade, record, nodes[t].right, hi);
+            lo = t;
+            pull(t);
+        } else {
+            split(nodes[t].left, grade, record, lo, nodes[t].left);
+            hi = t;
+            pull(t);
+        }
+    }
+    
+    // join two trees, every node of lo ranking before every node of hi
+    uint32_t join(uint32_t lo, uint32_t hi) {
+        if (lo == 0 || hi == 0) return lo + hi;
+        if (nodes[lo].priority > nodes[hi].priority) {
+            nodes[lo].right = join(nodes[lo].right, hi);
+            pull(lo);
+            return lo;
+        }
+        nodes[hi].left = join(lo, nodes[hi].left);
+        pull(hi);
+        return hi;
+    }
+    
+public:
+    GradeRankIndex() : nodes(1, Node{0, 0, 0, 0, 0, 0}), root(0), rng(12345) {}
+    
+    size_t size() const { return nodes[root].size; }
+    
+    void insert(float grade, uint32_t record) {
+        uint32_t t = nodes.size();
+        if (freeNodes.empty()) {
+            nodes.push_back(Node());
+        } else {
+            t = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        nodes[t] = Node{grade, record, (uint32_t)rng(), 1, 0, 0};
+        uint32_t lo, hi;
+        split(root, grade, record, lo, hi);
+        root = join(join(lo, t), hi);
+    }
+    
+    // remove (grade, record), false if it is not in the index
+    bool erase(float grade, uint32_t record) {
+        uint32_t lo, mid, hi;
+        split(root, grade, record, lo, hi);
+        split(hi, grade, record + 1, mid, hi);  // mid: just (grade, record)
+        root = join(lo, hi);
+        if (mid == 0) return false;
+        freeNodes.push_back(mid);
+        return true;
+    }
+    
+    void update(uint32_t record, float oldGrade, float newGrade) {
+        erase(oldGrade, record);
+        insert(newGrade, record);
+    }
+    
+    // 1 + number of records with a higher grade, so equal grades share a rank
+    size_t rankOf(float grade) const {
+        size_t above = 0;
+        uint32_t t = root;
+        while (t != 0) {
+            if (nodes[t].grade > grade) {
+                above += nodes[nodes[t].left].size + 1;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
+            }
+        }
+        return above + 1;
+    }
+    
+    // record of the k-th best student (k from 1), or -1
+    long kth(size_t k) const {
+        uint32_t t = root;
+        while (t != 0) {
+            size_t leftSize = nodes[nodes[t].left].size;
+            if (k <= leftSize) {
+                t = nodes[t].left;
+            } else if (k == leftSize + 1) {
+                return nodes[t].record;
+            } else {
+                k -= leftSize + 1;
+                t = nodes[t].right;
+            }
         }
+        return -1;
+    }
+    
+    // all records, best first
+    vector<uint32_t> inOrder() const {
+        vector<uint32_t> order, path;
+        order.reserve(size());
+        uint32_t t = root;
+        while (t != 0 || !path.empty()) {
+            while (t != 0) {
+                path.push_back(t);
+                t = nodes[t].left;
+            }
+            t = path.back();
+            path.pop_back();
+            order.push_back(nodes[t].record);
+            t = nodes[t].right;
+        }
+        return order;
+    }
+};
+
+// Top-k selection: the k first elements under less, in order, end up in
+// arr[0..k) and the rest is left unordered. nth_element is O(n) on average
+// and sorting the prefix O(k log k), instead of O(n log n) for a full sort.
+template <class T, class Less>
+void selectTopK(vector<T>& arr, size_t k, Less less) {
+    k = min(k, arr.size());
+    if (k < arr.size()) nth_element(arr.begin(), arr.begin() + k, arr.end(), less);
+    sort(arr.begin(), arr.begin() + k, less);
+}
+
+// best first: higher grade, then earlier record, the rank index's order
+inline bool rankedBefore(const GradeKey& a, const GradeKey& b) {
+    return a.grade > b.grade || (a.grade == b.grade && a.index < b.index);
+}
+
+// Sort Benchmark
+// Timing and operation counting shared by compareSortingComplexity and
+// --bench-sorts. Operation counts come from sorting CountedKeys: every
+// comparison of two grades and every copy of an element is counted (a swap
+// is three moves); radix sort reads grades without comparing them.
+struct SortCounters {
+    unsigned long long comparisons;
+    unsigned long long moves;
+};
+
+SortCounters sortCounters = {0, 0};
+
+// Grade that counts its comparisons
+struct CountedGrade {
+    float value;
+    operator float() const { return value; }
+};
+
+inline bool operator<(CountedGrade a, CountedGrade b) { sortCounters.comparisons++; return a.value < b.value; }
+inline bool operator>(CountedGrade a, CountedGrade b) { sortCounters.comparisons++; return a.value > b.value; }
+inline bool operator<=(CountedGrade a, CountedGrade b) { sortCounters.comparisons++; return a.value <= b.value; }
+inline bool operator>=(CountedGrade a, CountedGrade b) { sortCounters.comparisons++; return a.value >= b.value; }
+
+// GradeKey that counts its copies
+struct CountedKey {
+    float grade;
+    uint32_t index;
+    
+    CountedKey() : grade(0), index(0) {}
+    CountedKey(float g, uint32_t i) : grade(g), index(i) {}
+    CountedKey(const CountedKey& other) : grade(other.grade), index(other.index) { sortCounters.moves++; }
+    CountedKey& operator=(const CountedKey& other) {
+        grade = other.grade;
+        index = other.index;
+        sortCounters.moves++;
+        return *this;
+    }
+};
+
+inline CountedGrade gradeOf(const CountedKey& k) {
+    CountedGrade g = {k.grade};
+    return g;
+}
+
+// Comparisons and moves sortFn makes on keys with these grades
+template <class SortFn>
+SortCounters countSortOps(const vector<float>& grades, SortFn sortFn) {
+    vector<CountedKey> keys;
+    keys.reserve(grades.size());
+    for (size_t i = 0; i < grades.size(); i++) keys.push_back(CountedKey(grades[i], i));
+    sortCounters.comparisons = 0;
+    sortCounters.moves = 0;
+    sortFn(keys);
+    return sortCounters;
+}
+
+// Times in milliseconds over the timed trials
+struct SortTiming {
+    int trials;
+    double median;
+    double min;
+    double ciLow;   // confidence interval for the median
+    double ciHigh;
+};
+
+// Distribution-free confidence interval for the median of k trials: with
+// the times sorted, [t(j), t(k+1-j)] holds the true median with probability
+// 1 - 2 P(Binomial(k, 1/2) < j). Returns the 0-based positions for the
+// largest j that keeps this at 95% or more; below 6 trials no j does and
+// the interval is simply min..max.
+inline pair<int, int> medianInterval(int k) {
+    double term = pow(0.5, k);   // P(X = 0)
+    double below = term;         // P(X <= i)
+    int j = 1;
+    for (int i = 1; i < k; i++) {
+        term = term * (k - i + 1) / i;
+        if (2 * (below + term) > 0.05) break;
+        below += term;
+        j = i + 1;
+    }
+    return make_pair(j - 1, k - j);
+}
+
+// Time sortFn on fresh copies of input: warmups untimed runs, then trials
+// timed ones (the copy is not timed). If the first run takes over two
+// seconds the trials are cut to 3, so 10^7-element sweeps stay practical.
+template <class T, class SortFn>
+SortTiming measureSort(const vector<T>& input, SortFn sortFn, int warmups, int trials) {
+    vector<double> times;
+    for (int run = 0; run < warmups + trials; run++) {
+        vector<T> work = input;
+        auto start = chrono::steady_clock::now();
+        sortFn(work);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (run == 0 && ms > 2000 && trials > 3) trials = 3;
+        if (run >= warmups) times.push_back(ms);
+    }
+    sort(times.begin(), times.end());
+    SortTiming timing;
+    timing.trials = trials;
+    timing.min = times[0];
+    timing.median = trials % 2 ? times[trials / 2] : (times[trials / 2 - 1] + times[trials / 2]) / 2;
+    pair<int, int> ci = medianInterval(trials);
+    timing.ciLow = times[ci.first];
+    timing.ciHigh = times[ci.second];
+    return timing;
+}
+
+// Student Performance Tracker System
+class StudentPerformanceTracker {
+private:
+    HashTable hashTable;
+    SortedIDIndex idIndex;
+    NameIndex nameIndex;
+    GradeRankIndex rankIndex;
+    vector<Student> studentArray;
+    
+public:
+    // Add a new student record
+    void addStudentRecord() {
+        int id;
+        string name, course;
+        float grade;
         
-        cout << "\n--- Sorting Algorithm Time Complexity Comparison ---" << endl;
-        cout << setw(20) << "Algorithm" << setw(20) << "Time (microseconds)" << endl;
-        cout << string(40, '-') << endl;
+        cout << "\nEnter Student ID: ";
+        cin >> id;
+        cin.ignore();
         
-        vector<Student> testArray;
+        cout << "Enter Student Name: ";
+        getline(cin, name);
         
-        // Bubble Sort
-        testArray = studentArray;
-        auto start = chrono::high_resolution_clock::now();
-        bubbleSort(testArray);
-        auto end = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        cout << setw(20) << "Bubble Sort" << setw(20) << duration.count() << endl;
-        
-        // Insertion Sort
-        testArray = studentArray;
-        start = chrono::high_resolution_clock::now();
-        insertionSort(testArray);
-        end = chrono::high_resolution_clock::now();
-        duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        cout << setw(20) << "Insertion Sort" << setw(20) << duration.count() << endl;
-        
-        // Merge Sort
-        testArray = studentArray;
-        start = chrono::high_resolution_clock::now();
-        mergeSort(testArray, 0, testArray.size() - 1);
-        end = chrono::high_resolution_clock::now();
-        duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        cout << setw(20) << "Merge Sort" << setw(20) << duration.count() << endl;
-        
-        // Quick Sort
-        testArray = studentArray;
-        start = chrono::high_resolution_clock::now();
-        quickSort(testArray, 0, testArray.size() - 1);
-        end = chrono::high_resolution_clock::now();
-        duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        cout << setw(20) << "Quick Sort" << setw(20) << duration.count() << endl;
-        
-        // Heap Sort
-        testArray = studentArray;
-        start = chrono::high_resolution_clock::now();
-        heapSort(testArray);
-        end = chrono::high_resolution_clock::now();
-        duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        cout << setw(20) << "Heap Sort" << setw(20) << duration.count() << endl;
+        cout << "Enter Grade: ";
+        cin >> grade;
+        cin.ignore();
         
-        cout << "\n--- Theoretical Time Complexities ---" << endl;
-        cout << "Bubble Sort:    O(n²) average and worst case" << endl;
-        cout << "Insertion Sort: O(n²) average and worst case, O(n) best case" << endl;
-        cout << "Merge Sort:     O(n log n) all cases" << endl;
-        cout << "Quick Sort:     O(n log n) average, O(n²) worst case" << endl;
-        cout << "Heap Sort:      O(n log n) all cases" << endl;
+        cout << "Enter Course Details: ";
+        getline(cin, course);
+        
+        Student newStudent(id, name, grade, course);
+        if (hashTable.insertStudent(newStudent)) {
+            idIndex.add(newStudent.studentID, studentArray.size());
+            nameIndex.add(newStudent.studentName, studentArray.size());
+            rankIndex.insert(newStudent.grade, studentArray.size());
+            studentArray.push_back(newStudent);
+        }
     }
     
-    // Search menu
-    void searchMenu() {
-        int choice;
-        cout << "\n--- Search Menu ---" << endl;
-        cout << "1. Sequential Search by Name" << endl;
-        cout << "2. Binary Search by ID" << endl;
-        cout << "3. Hash Table Search by ID" << endl;
-        cout << "Enter choice: ";
-        cin >> choice;
+    // Sequential Search by name
+    void sequentialSearchByName(string name) {
+        bool found = false;
+        cout << "\n--- Sequential Search Results ---" << endl;
         
-        switch (choice) {
-            case 1: {
-                string name;
-                cin.ignore();
-                cout << "Enter student name: ";
-                getline(cin, name);
-                sequentialSearchByName(name);
-                break;
-            }
-            case 2: {
-                int id;
-                cout << "Enter student ID: ";
-                cin >> id;
-                binarySearchByID(id);
-                break;
-            }
-            case 3: {
-                int id;
-                cout << "Enter student ID: ";
-                cin >> id;
-                Student* result = hashTable.searchByID(id);
-                if (result != nullptr) {
-                    cout << "\n--- Hash Table Search Result ---" << endl;
-                    result->display();
-                } else {
-                    cout << "Student not found!" << endl;
-                }
-                break;
+        for (int i = 0; i < studentArray.size(); i++) {
+            if (studentArray[i].studentName == name) {
+                studentArray[i].display();
+                found = true;
             }
         }
+        
+        if (!found) {
+            cout << "Student not found!" << endl;
+        }
     }
     
-    // Display all students
-    void displayAllStudents() {
-        if (studentArray.empty()) {
-            cout << "No students in the system!" << endl;
-            return;
+    // Name search on the name index: exact matches, then names starting
+    // with the query, then names within two typos of it
+    void indexedSearchByName(string query) {
+        vector<int> shown = nameIndex.exact(query);
+        auto isNew = [&shown](int r) {
+            if (find(shown.begin(), shown.end(), r) != shown.end()) return false;
+            shown.push_back(r);
+            return true;
+        };
+        vector<int> starts;
+        for (int r : nameIndex.prefix(query, 20)) {
+            if (isNew(r)) starts.push_back(r);
+        }
+        vector<pair<int, int>> close;
+        for (auto& c : nameIndex.fuzzy(query, 2, 10)) {
+            if (isNew(c.first)) close.push_back(c);
         }
         
-        cout << "\n--- All Students ---" << endl;
-        for (int i = 0; i < studentArray.size(); i++) {
-            studentArray[i].display();
+        cout << "\n--- Name Index Search Results ---" << endl;
+        if (shown.empty()) {
+            cout << "Student not found!" << endl;
+            return;
+        }
+        size_t exactCount = shown.size() - starts.size() - close.size();
+        if (exactCount > 0) {
+            cout << "Exact matches:" << endl;
+            for (size_t i = 0; i < exactCount; i++) studentArray[shown[i]].display();
+        }
+        if (!starts.empty()) {
+            cout << "Names starting with \"" << query << "\":" << endl;
+            for (int r : starts) studentArray[r].display();
+        }
+        if (!close.empty()) {
+            cout << "Close matches (up to 2 typos):" << endl;
+            for (auto& c : close) {
+                cout << "[" << c.second << "] ";
+                studentArray[c.first].display();
+            }
         }
     }
     
-    // Add sample data for testing
-    void addSampleData() {
-        studentArray.push_back(Student(101, "Alice Johnson", 85.5, "Computer Science"));
-        studentArray.push_back(Student(102, "Bob Smith", 92.3, "Mathematics"));
-        studentArray.push_back(Student(103, "Charlie Brown", 78.9, "Physics"));
-        studentArray.push_back(Student(104, "Diana Prince", 88.7, "Chemistry"));
-        studentArray.push_back(Student(105, "Eva Green", 95.2, "Biology"));
-        
-        for (int i = 0; i < studentArray.size(); i++) {
-            hashTable.insertStudent(studentArray[i]);
+    // Binary Search by ID, on the sorted ID index
+    void binarySearchByID(int id) {
+        long r = idIndex.find(id);
+        if (r >= 0) {
+            cout << "\n--- Binary Search Result ---" << endl;
+            studentArray[r].display();
+        } else {
+            cout << "Student not found!" << endl;
         }
-        
-        cout << "Sample data added successfully!" << endl;
     }
-};
-
-// Main function
-int main() {
+    
+    // The five sorts below are templates over the element type and read
+    // the grade through gradeOf(), so they run unchanged on Student
+    // records or on GradeKey pairs (indirect mode).
+    
+    // Bubble Sort by grades
+    template <class T>
+    void bubbleSort(vector<T>& arr) {
+        int n = arr.size();
+        for (int i = 0; i < n - 1; i++) {
+            for (int j = 0; j < n - i - 1; j++) {
+                if (gradeOf(arr[j]) > gradeOf(arr[j + 1])) {
+                    swap(arr[j], arr[j + 1]);
+                }
+            }
+        }
+    }
+    
+    // Insertion Sort by grades
+    template <class T>
+    void insertionSort(vector<T>& arr) {
+        int n = arr.size();
+        for (int i = 1; i < n; i++) {
+            T key = arr[i];
+            int j = i - 1;
+            
+            while (j >= 0 && gradeOf(arr[j]) > gradeOf(key)) {
+                arr[j + 1] = arr[j];
+                j--;
+            }
+            arr[j + 1] = key;
+        }
+    }
+    
+    // Merge Sort by grades, arr[left..right]: natural bottom-up merge sort
+    // with one scratch buffer (see naturalMergeSortBy)
+    template <class T>
+    void mergeSort(vector<T>& arr, int left, int right) {
+        if (left < right) {
+            naturalMergeSortBy(arr, left, right + 1, GradeLess());
+        }
+    }
+    
+    // Quick Sort by grades (introsort, see introSortBy), arr[low..high]
+    template <class T>
+    void quickSort(vector<T>& arr, int low, int high) {
+        if (low < high) {
+            introSortBy(arr, low, high + 1, GradeLess());
+        }
+    }
+    
+    // Heapify for heap sort
+    template <class T>
+    void heapify(vector<T>& arr, int n, int i) {
+        int largest = i;
+        int left = 2 * i + 1;
+        int right = 2 * i + 2;
+        
+        if (left < n && gradeOf(arr[left]) > gradeOf(arr[largest]))
+            largest = left;
+        
+        if (right < n && gradeOf(arr[right]) > gradeOf(arr[largest]))
+            largest = right;
+        
+        if (largest != i) {
+            swap(arr[i], arr[largest]);
+            heapify(arr, n, largest);
+        }
+    }
+    
+    // Heap Sort by grades (for ranking)
+    template <class T>
+    void heapSort(vector<T>& arr) {
+        int n = arr.size();
+        
+        // Build heap
+        for (int i = n / 2 - 1; i >= 0; i--)
+            heapify(arr, n, i);
+        
+        // Extract elements from heap
+        for (int i = n - 1; i > 0; i--) {
+            swap(arr[0], arr[i]);
+            heapify(arr, i, 0);
+        }
+    }
+    
+    // LSD Radix Sort by grades: three stable counting passes of 11, 11 and
+    // 10 bits over floatOrderKey(grade), so equal grades keep their input
+    // order. All three histograms come from one read of the input, and a
+    // pass where every key has the same digit is skipped. Below 64 records
+    // clearing the 24 KB of counters costs more than the sort, so short
+    // arrays go to smallSortRange, which is stable as well.
+    template <class T>
+    void radixSort(vector<T>& arr) {
+        const int BITS = 11, RADIX = 1 << BITS, PASSES = 3;
+        size_t n = arr.size();
+        if (n < 64) {
+            smallSortRange(arr, 0, n, GradeLess());
+            return;
+        }
+        
+        vector<uint32_t> count(PASSES * RADIX, 0);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t key = floatOrderKey(gradeOf(arr[i]));
+            for (int p = 0; p < PASSES; p++) {
+                count[p * RADIX + ((key >> (p * BITS)) & (RADIX - 1))]++;
+            }
+        }
+        
+        uint32_t firstKey = floatOrderKey(gradeOf(arr[0]));
+        vector<T> buffer(n);
+        vector<T>* from = &arr;
+        vector<T>* to = &buffer;
+        for (int p = 0; p < PASSES; p++) {
+            int shift = p * BITS;
+            uint32_t* c = &count[p * RADIX];
+            if (c[(firstKey >> shift) & (RADIX - 1)] == n) continue;
+            
+            uint32_t sum = 0;
+            for (int d = 0; d < RADIX; d++) {
+                uint32_t here = c[d];
+                c[d] = sum;
+                sum += here;
+            }
+            for (size_t i = 0; i < n; i++) {
+                uint32_t d = (floatOrderKey(gradeOf((*from)[i])) >> shift) & (RADIX - 1);
+                (*to)[c[d]++] = move((*from)[i]);
+            }
+            swap(from, to);
+        }
+        if (from != &arr) arr = move(*from);
+    }
+    
+    // Parallel Merge Sort by grades on pool. Stable, like mergeSort, so the
+    // result is exactly mergeSort's.
+    template <class T>
+    void parallelMergeSort(vector<T>& arr, ThreadPool& pool) {
+        parallelMergeSortBy(arr, GradeLess(), pool);
+    }
+    
+    // Parallel Quick Sort by grades on pool. The partition is stable, so
+    // equal grades keep their input order, which quickSort does not
+    // promise; otherwise the results match. Only --bench-parallel uses it.
+    template <class T>
+    void parallelQuickSort(vector<T>& arr, ThreadPool& pool) {
+        parallelQuickSortBy(arr, GradeLess(), pool);
+    }
+    
+    // Run sorting algorithm choice (1-6) on arr; other values leave it as is
+    template <class T>
+    void runSort(vector<T>& arr, int choice) {
+        switch (choice) {
+            case 1: bubbleSort(arr); break;
+            case 2: insertionSort(arr); break;
+            case 3: mergeSort(arr, 0, arr.size() - 1); break;
+            case 4: quickSort(arr, 0, arr.size() - 1); break;
+            case 5: heapSort(arr); break;
+            case 6: radixSort(arr); break;
+        }
+    }
+    
+    // Indirect sort: sort (grade, index) keys with the chosen algorithm and
+    // return the order, order[i] = position of the i-th record once sorted.
+    // The algorithms only look at grades, so this is exactly the order the
+    // same algorithm gives when it moves the records themselves. Large
+    // merge sorts run on the shared pool when there is more than one
+    // hardware thread; quick sort does not, since the parallel one orders
+    // equal grades differently.
+    vector<uint32_t> sortedOrder(const vector<Student>& arr, int choice) {
+        vector<GradeKey> keys(arr.size());
+        for (size_t i = 0; i < arr.size(); i++) keys[i] = {arr[i].grade, (uint32_t)i};
+        bool parallel = keys.size() >= PARALLEL_MIN_SIZE && choice == 3 && sortPool().threadCount() > 1;
+        if (parallel) parallelMergeSort(keys, sortPool());
+        else runSort(keys, choice);
+        vector<uint32_t> order(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) order[i] = keys[i].index;
+        return order;
+    }
+    
+    // Put arr into the given order in place, following the cycles of the
+    // permutation, so every record is moved exactly once
+    static void applyOrder(vector<Student>& arr, vector<uint32_t> order) {
+        for (size_t i = 0; i < arr.size(); i++) {
+            if (order[i] == i) continue;
+            Student tmp = move(arr[i]);
+            size_t j = i;
+            while (order[j] != i) {
+                size_t k = order[j];
+                arr[j] = move(arr[k]);
+                order[j] = j;
+                j = k;
+            }
+            arr[j] = move(tmp);
+            order[j] = j;
+        }
+    }
+    
+    // Indirect sort that leaves arr itself sorted
+    void sortIndirect(vector<Student>& arr, int choice) {
+        applyOrder(arr, sortedOrder(arr, choice));
+    }
+    
+    // Sort by grades using selected algorithm (indirect: only the
+    // (grade, index) keys are sorted, the records are not moved)
+    void sortByGrades(int choice) {
+        if (studentArray.empty()) {
+            cout << "No students to sort!" << endl;
+            return;
+        }
+        
+        const char* names[] = {"", "Bubble Sort", "Insertion Sort", "Merge Sort", "Quick Sort", "Heap Sort", "Radix Sort"};
+        
+        auto start = chrono::high_resolution_clock::now();
+        
+        vector<uint32_t> order = sortedOrder(studentArray, choice);
+        if (choice >= 1 && choice <= 6) {
+            cout << "Sorted using " << names[choice] << endl;
+        }
+        
+        auto end = chrono::high_resolution_clock::now();
+        auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
+        
+        cout << "\n--- Sorted Students by Grade ---" << endl;
+        for (size_t i = 0; i < order.size(); i++) {
+            studentArray[order[i]].display();
+        }
+        
+        cout << "\nTime taken: " << duration.count() << " microseconds" << endl;
+    }
+    
+    // Change a student's grade in the table, the array and the rank index
+    bool updateGrade(int id, float grade) {
+        long r = idIndex.find(id);
+        if (r < 0) return false;
+        rankIndex.update(r, studentArray[r].grade, grade);
+        studentArray[r].grade = grade;
+        hashTable.searchByID(id)->grade = grade;
+        return true;
+    }
+    
+    // Records of the k best students, best first, without sorting the rest
+    vector<uint32_t> topPerformers(size_t k) const {
+        vector<GradeKey> keys(studentArray.size());
+        for (size_t i = 0; i < keys.size(); i++) keys[i] = {studentArray[i].grade, (uint32_t)i};
+        selectTopK(keys, k, rankedBefore);
+        vector<uint32_t> top(min(k, keys.size()));
+        for (size_t i = 0; i < top.size(); i++) top[i] = keys[i].index;
+        return top;
+    }
+    
+    // ranks come from the rank index, so equal grades share a rank
+    void displayRanked(const vector<uint32_t>& order) {
+        for (size_t i = 0; i < order.size(); i++) {
+            cout << "Rank " << rankIndex.rankOf(studentArray[order[i]].grade) << ": ";
+            studentArray[order[i]].display();
+        }
+    }
+    
+    // Rankings: the full list is read off the rank index in O(n), top k is
+    // a selection, single ranks and the k-th best are O(log n) queries
+    void rankByPerformance() {
+        if (studentArray.empty()) {
+            cout << "No students to rank!" << endl;
+            return;
+        }
+        
+        int choice;
+        cout << "\n--- Ranking Menu ---" << endl;
+        cout << "1. Full Ranking" << endl;
+        cout << "2. Top k Students" << endl;
+        cout << "3. Rank of a Student (by ID)" << endl;
+        cout << "4. k-th Best Student" << endl;
+        cout << "5. Update a Student's Grade" << endl;
+        cout << "Enter choice: ";
+        cin >> choice;
+        
+        switch (choice) {
+            case 1:
+                cout << "\n--- Student Rankings (Highest to Lowest) ---" << endl;
+                displayRanked(rankIndex.inOrder());
+                break;
+            case 2: {
+                int k;
+                cout << "Enter k: ";
+                cin >> k;
+                cout << "\n--- Top " << k << " Students ---" << endl;
+                displayRanked(topPerformers(max(k, 0)));
+                break;
+            }
+            case 3: {
+                int id;
+                cout << "Enter student ID: ";
+                cin >> id;
+                long r = idIndex.find(id);
+                if (r < 0) {
+                    cout << "Student not found!" << endl;
+                    break;
+                }
+                cout << "Rank " << rankIndex.rankOf(studentArray[r].grade) << " of " << rankIndex.size() << ": ";
+                studentArray[r].display();
+                break;
+            }
+            case 4: {
+                int k;
+                cout << "Enter k: ";
+                cin >> k;
+                long r = k > 0 ? rankIndex.kth(k) : -1;
+                if (r < 0) {
+                    cout << "There are only " << rankIndex.size() << " students!" << endl;
+                    break;
+                }
+                cout << "Student " << k << " in the ranking: ";
+                studentArray[r].display();
+                break;
+            }
+            case 5: {
+                int id;
+                float grade;
+                cout << "Enter student ID: ";
+                cin >> id;
+                cout << "Enter new grade: ";
+                cin >> grade;
+                if (updateGrade(id, grade)) {
+                    long r = idIndex.find(id);
+                    cout << "Grade updated, now rank " << rankIndex.rankOf(grade) << " of " << rankIndex.size() << endl;
+                    studentArray[r].display();
+                } else {
+                    cout << "Student not found!" << endl;
+                }
+                break;
+            }
+            default:
+                cout << "Invalid choice!" << endl;
+        }
+    }
+    
+    // Compare sorting algorithms on the current students: one warmup run
+    // and 15 timed runs each, reported as median and minimum with a 95%
+    // interval for the median, plus comparison and move counts. Sizes and
+    // input orders are swept by --bench-sorts.
+    void compareSortingComplexity() {
+        if (studentArray.size() < 2) {
+            cout << "Need at least 2 students to compare sorting algorithms!" << endl;
+            return;
+        }
+        
+        const char* names[] = {"", "Bubble Sort", "Insertion Sort", "Merge Sort", "Quick Sort", "Heap Sort", "Radix Sort"};
+        vector<float> grades;
+        for (size_t i = 0; i < studentArray.size(); i++) grades.push_back(studentArray[i].grade);
+        
+        cout << "\n--- Sorting Algorithm Time Complexity Comparison ---" << endl;
+        cout << studentArray.size() << " students, 1 warmup + 15 timed runs, times in microseconds" << endl;
+        cout << setw(16) << "Algorithm" << setw(10) << "median" << setw(10) << "min"
+             << setw(20) << "95% CI (median)" << setw(13) << "comparisons" << setw(8) << "moves" << endl;
+        cout << string(77, '-') << endl;
+        
+        cout << fixed << setprecision(2);
+        for (int choice = 1; choice <= 6; choice++) {
+            SortTiming timing = measureSort(studentArray, [this, choice](vector<Student>& v) { runSort(v, choice); }, 1, 15);
+            SortCounters ops = countSortOps(grades, [this, choice](vector<CountedKey>& v) { runSort(v, choice); });
+            ostringstream ci;
+            ci << fixed << setprecision(2) << timing.ciLow * 1000 << " - " << timing.ciHigh * 1000;
+            cout << setw(16) << names[choice] << setw(10) << timing.median * 1000 << setw(10) << timing.min * 1000
+                 << setw(20) << ci.str() << setw(13) << ops.comparisons << setw(8) << ops.moves << endl;
+        }
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+        
+        cout << "\n--- Theoretical Time Complexities ---" << endl;
+        cout << "Bubble Sort:    O(n²) average and worst case" << endl;
+        cout << "Insertion Sort: O(n²) average and worst case, O(n) best case" << endl;
+        cout << "Merge Sort:     O(n log n) all cases" << endl;
+        cout << "Quick Sort:     O(n log n) all cases (introsort: heap sort fallback)" << endl;
+        cout << "Heap Sort:      O(n log n) all cases" << endl;
+        cout << "Radix Sort:     O(n) all cases (3 passes over 32-bit keys), stable" << endl;
+    }
+    
+    // Search menu
+    void searchMenu() {
+        int choice;
+        cout << "\n--- Search Menu ---" << endl;
+        cout << "1. Sequential Search by Name" << endl;
+        cout << "2. Binary Search by ID" << endl;
+        cout << "3. Hash Table Search by ID" << endl;
+        cout << "4. Name Index Search (exact, prefix, typo-tolerant)" << endl;
+        cout << "Enter choice: ";
+        cin >> choice;
+        
+        switch (choice) {
+            case 1: {
+                string name;
+                cin.ignore();
+                cout << "Enter student name: ";
+                getline(cin, name);
+                sequentialSearchByName(name);
+                break;
+            }
+            case 2: {
+                int id;
+                cout << "Enter student ID: ";
+                cin >> id;
+                binarySearchByID(id);
+                break;
+            }
+            case 3: {
+                int id;
+                cout << "Enter student ID: ";
+                cin >> id;
+                Student* result = hashTable.searchByID(id);
+                if (result != nullptr) {
+                    cout << "\n--- Hash Table Search Result ---" << endl;
+                    result->display();
+                } else {
+                    cout << "Student not found!" << endl;
+                }
+                break;
+            }
+            case 4: {
+                string name;
+                cin.ignore();
+                cout << "Enter name, prefix or misspelled name: ";
+                getline(cin, name);
+                indexedSearchByName(name);
+                break;
+            }
+        }
+    }
+    
+    // Display all students
+    void displayAllStudents() {
+        if (studentArray.empty()) {
+            cout << "No students in the system!" << endl;
+            return;
+        }
+        
+        cout << "\n--- All Students ---" << endl;
+        for (int i = 0; i < studentArray.size(); i++) {
+            studentArray[i].display();
+        }
+    }
+    
+    // Add sample data for testing
+    void addSampleData() {
+        vector<Student> samples;
+        samples.push_back(Student(101, "Alice Johnson", 85.5, "Computer Science"));
+        samples.push_back(Student(102, "Bob Smith", 92.3, "Mathematics"));
+        samples.push_back(Student(103, "Charlie Brown", 78.9, "Physics"));
+        samples.push_back(Student(104, "Diana Prince", 88.7, "Chemistry"));
+        samples.push_back(Student(105, "Eva Green", 95.2, "Biology"));
+        
+        // only IDs that are not in the table yet
+        for (size_t i = 0; i < samples.size(); i++) {
+            if (hashTable.insertStudent(samples[i])) {
+                idIndex.add(samples[i].studentID, studentArray.size());
+                nameIndex.add(samples[i].studentName, studentArray.size());
+                rankIndex.insert(samples[i].grade, studentArray.size());
+                studentArray.push_back(samples[i]);
+            }
+        }
+        
+        cout << "Sample data added successfully!" << endl;
+    }
+};
+
+// The original chained table (100 fixed buckets, append at the chain
+// tail), kept only as the baseline for --bench-hash.
+class ChainedHashTable {
+private:
+    struct HashNode {
+        Student data;
+        HashNode* next;
+    };
+    
+    static const int TABLE_SIZE = 100;
+    HashNode* table[TABLE_SIZE];
+    
+public:
+    ChainedHashTable() {
+        for (int i = 0; i < TABLE_SIZE; i++) table[i] = nullptr;
+    }
+    
+    ~ChainedHashTable() {
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            while (table[i] != nullptr) {
+                HashNode* next = table[i]->next;
+                delete table[i];
+                table[i] = next;
+            }
+        }
+    }
+    
+    void insertStudent(Student student) {
+        int index = student.studentID % TABLE_SIZE;
+        HashNode* newNode = new HashNode{student, nullptr};
+        if (table[index] == nullptr) {
+            table[index] = newNode;
+        } else {
+            HashNode* current = table[index];
+            while (current->next != nullptr) current = current->next;
+            current->next = newNode;
+        }
+    }
+    
+    Student* searchByID(int id) {
+        for (HashNode* current = table[id % TABLE_SIZE]; current != nullptr; current = current->next) {
+            if (current->data.studentID == id) return &(current->data);
+        }
+        return nullptr;
+    }
+};
+
+// Random student records with the distinct IDs 100000 .. 100000+n-1 in
+// shuffled order, so any ID from 100000+n on is a guaranteed miss.
+vector<Student> makeStudents(int n, unsigned seed) {
+    mt19937 rng(seed);
+    string first[] = {"Alice", "Bob", "Charlie", "Diana", "Eva", "Farhan", "Gita", "Harsh"};
+    string last[] = {"Johnson", "Smith", "Brown", "Prince", "Green", "Khan", "Rao", "Mehta"};
+    string courses[] = {"Computer Science", "Mathematics", "Physics", "Chemistry", "Biology"};
+    vector<int> ids(n);
+    for (int i = 0; i < n; i++) ids[i] = i;
+    shuffle(ids.begin(), ids.end(), rng);
+    vector<Student> students;
+    students.reserve(n);
+    for (int i = 0; i < n; i++) {
+        students.push_back(Student(100000 + ids[i], first[rng() % 8] + " " + last[rng() % 8],
+                                   (rng() % 1001) / 10.0f, courses[rng() % 5]));
+    }
+    return students;
+}
+
+// time searchByID over keys on either table, counting the records found
+template <class Table>
+double lookup(Table& table, const vector<int>& keys, long& found) {
+    auto start = chrono::steady_clock::now();
+    for (int id : keys) found += table.searchByID(id) != nullptr;
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Robin Hood table against the chained one: build, hit and miss lookups,
+// then delete every other student and look everything up again.
+void benchHashTable(int n) {
+    vector<Student> students = makeStudents(n, 3);
+    vector<int> hits(n), misses(n);
+    for (int i = 0; i < n; i++) {
+        hits[i] = students[(i * 7919L) % n].studentID;
+        misses[i] = 100000 + n + (int)((i * 7919L) % n);
+    }
+    
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    ChainedHashTable chained;
+    auto start = chrono::steady_clock::now();
+    for (const Student& s : students) chained.insertStudent(s);
+    double chainedBuild = ms(start);
+    long chainedHits = 0, chainedMisses = 0;
+    double chainedHit = lookup(chained, hits, chainedHits);
+    double chainedMiss = lookup(chained, misses, chainedMisses);
+    
+    HashTable robin;
+    start = chrono::steady_clock::now();
+    for (const Student& s : students) robin.insertStudent(s, true);
+    double robinBuild = ms(start);
+    long robinHits = 0, robinMisses = 0;
+    double robinHit = lookup(robin, hits, robinHits);
+    double robinMiss = lookup(robin, misses, robinMisses);
+    int probe = robin.maxProbe();
+    
+    for (int i = 0; i < n; i += 2) robin.removeStudent(students[i].studentID);
+    long afterDelete = 0;
+    for (int i = 0; i < n; i++) {
+        Student* s = robin.searchByID(students[i].studentID);
+        if ((s != nullptr) == (i % 2 == 1) && (s == nullptr || s->studentID == students[i].studentID)) afterDelete++;
+    }
+    
+    cout << n << " students, " << n << " hit and " << n << " miss lookups (ms)" << endl;
+    cout << setw(16) << "" << setw(12) << "build" << setw(12) << "hits" << setw(12) << "misses" << endl;
+    cout << setw(16) << "chained (100)" << setw(12) << chainedBuild << setw(12) << chainedHit << setw(12) << chainedMiss << endl;
+    cout << setw(16) << "Robin Hood" << setw(12) << robinBuild << setw(12) << robinHit << setw(12) << robinMiss << endl;
+    cout << "Robin Hood: capacity " << robin.capacity() << ", longest probe " << probe
+         << ", found " << robinHits << "/" << n << " hits and " << robinMisses << " misses"
+         << (robinHits == chainedHits && robinMisses == chainedMisses ? " (same as chained)" : " (MISMATCH)") << endl;
+    cout << "After deleting every other student: " << afterDelete << "/" << n << " lookups correct" << endl;
+}
+
+// The old binarySearchByID: copy the array, bubble sort it by ID, then
+// binary search. Kept only as the baseline for --bench-search.
+bool copySortAndSearch(const vector<Student>& studentArray, int id) {
+    vector<Student> sortedArray = studentArray;
+    for (int i = 0; i + 1 < (int)sortedArray.size(); i++) {
+        for (int j = 0; j < (int)sortedArray.size() - i - 1; j++) {
+            if (sortedArray[j].studentID > sortedArray[j + 1].studentID) {
+                swap(sortedArray[j], sortedArray[j + 1]);
+            }
+        }
+    }
+    int left = 0, right = sortedArray.size() - 1;
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+        if (sortedArray[mid].studentID == id) return true;
+        if (sortedArray[mid].studentID < id) left = mid + 1;
+        else right = mid - 1;
+    }
+    return false;
+}
+
+// ID lookups: Eytzinger index against lower_bound on a sorted array, and
+// (on a small array, it is quadratic) against the old copy-and-sort search.
+void benchSearch(int n, int queries) {
+    vector<Student> students = makeStudents(n, 4);
+    SortedIDIndex index;
+    for (int i = 0; i < n; i++) index.add(students[i].studentID, i);
+    vector<pair<int, uint32_t>> sorted(n);
+    for (int i = 0; i < n; i++) sorted[i] = {students[i].studentID, (uint32_t)i};
+    sort(sorted.begin(), sorted.end());
+    
+    mt19937 rng(9);
+    vector<int> keys(queries);
+    for (int& k : keys) k = 100000 + rng() % (n + n / 4);  // about 20% misses
+    index.find(0);  // build outside the timed loop
+    
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    long sumStd = 0, sumEytz = 0;
+    auto start = chrono::steady_clock::now();
+    for (int k : keys) {
+        auto it = lower_bound(sorted.begin(), sorted.end(), make_pair(k, (uint32_t)0));
+        sumStd += (it != sorted.end() && it->first == k) ? (long)it->second : -1;
+    }
+    double stdMs = ms(start);
+    start = chrono::steady_clock::now();
+    for (int k : keys) sumEytz += index.find(k);
+    double eytzMs = ms(start);
+    
+    int small = min(n, 2000), smallQueries = 20;
+    vector<Student> few(students.begin(), students.begin() + small);
+    start = chrono::steady_clock::now();
+    int oldFound = 0;
+    for (int q = 0; q < smallQueries; q++) oldFound += copySortAndSearch(few, few[q * 97 % small].studentID);
+    double oldMs = ms(start) / smallQueries;
+    
+    cout << n << " students, " << queries << " ID lookups:" << endl;
+    cout << "  lower_bound on sorted array : " << stdMs << " ms" << endl;
+    cout << "  Eytzinger index             : " << eytzMs << " ms"
+         << (sumStd == sumEytz ? "  (same results)" : "  (MISMATCH)") << endl;
+    cout << "  old copy + bubble sort      : " << oldMs << " ms per lookup at only " << small
+         << " students (" << oldFound << "/" << smallQueries << " found)" << endl;
+}
+
+// Ranking n students: a full heap sort (the old rankByPerformance) against
+// top-100 selection, and the rank index's build, rank, k-th and update
+// costs. The index is checked against a sort of the final grades.
+void benchRank(int n, int queries) {
+    mt19937 rng(21);
+    vector<float> grades(n);
+    for (float& g : grades) g = (rng() % 10001) / 100.0f;
+    vector<GradeKey> keys(n);
+    for (int i = 0; i < n; i++) keys[i] = {grades[i], (uint32_t)i};
+    
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    StudentPerformanceTracker t;
+    vector<GradeKey> work = keys;
+    auto start = chrono::steady_clock::now();
+    t.heapSort(work);
+    double heapMs = ms(start);
+    work = keys;
+    start = chrono::steady_clock::now();
+    selectTopK(work, 100, rankedBefore);
+    double topMs = ms(start);
+    
+    GradeRankIndex index;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) index.insert(grades[i], i);
+    double buildMs = ms(start);
+    
+    vector<uint32_t> picks(queries);
+    for (uint32_t& p : picks) p = rng() % n;
+    long sum = 0;
+    start = chrono::steady_clock::now();
+    for (uint32_t p : picks) sum += index.rankOf(grades[p]);
+    double rankMs = ms(start);
+    start = chrono::steady_clock::now();
+    for (uint32_t p : picks) sum += index.kth(p + 1);
+    double kthMs = ms(start);
+    start = chrono::steady_clock::now();
+    for (uint32_t p : picks) {
+        float g = (rng() % 10001) / 100.0f;
+        index.update(p, grades[p], g);
+        grades[p] = g;
+    }
+    double updateMs = ms(start);
+    
+    for (int i = 0; i < n; i++) keys[i] = {grades[i], (uint32_t)i};
+    sort(keys.begin(), keys.end(), rankedBefore);
+    vector<uint32_t> order = index.inOrder();
+    bool same = order.size() == (size_t)n && index.size() == (size_t)n;
+    for (int i = 0; same && i < n; i++) same = order[i] == keys[i].index;
+    for (int q = 0; same && q < 1000; q++) {
+        size_t i = rng() % n;
+        size_t first = lower_bound(keys.begin(), keys.end(), keys[i], [](const GradeKey& a, const GradeKey& b) {
+            return a.grade > b.grade;
+        }) - keys.begin();
+        same = index.rankOf(keys[i].grade) == first + 1 && index.kth(i + 1) == (long)keys[i].index;
+    }
+    
+    cout << n << " students, " << queries << " queries/updates (checksum " << sum << "):" << endl;
+    cout << "  heap sort, full ranking : " << heapMs << " ms" << endl;
+    cout << "  top-100 selection       : " << topMs << " ms" << endl;
+    cout << "  rank index build        : " << buildMs << " ms" << endl;
+    cout << "  rank of a grade         : " << rankMs * 1e6 / queries << " ns each" << endl;
+    cout << "  k-th best               : " << kthMs * 1e6 / queries << " ns each" << endl;
+    cout << "  grade update            : " << updateMs * 1e6 / queries << " ns each" << endl;
+    cout << "  index after updates     : " << (same ? "matches a full sort" : "MISMATCH") << endl;
+}
+
+// Small-n sorting (--bench-small): many short arrays of GradeKeys, like
+// per-course groups. First the base-case kernels on their own (insertion
+// sort, scalar network, AVX2 network), then introsort and merge sort with
+// an insertion sort base (a lambda comparator, which smallSortRange does
+// not recognise) against GradeLess, which brings in the network. Every
+// result is checked against std::stable_sort.
+void benchSmallSorts(int totalKeys) {
+    const int sizes[] = {4, 8, 12, 16, 24, 32, 48, 64, 128, 256, 1024};
+    const char* names[] = {"insertion sort", "network, scalar", "network, AVX2", "introsort, insertion base",
+                           "introsort, network base", "merge sort, insertion base", "merge sort, network base"};
+    auto plainLess = [](const GradeKey& a, const GradeKey& b) { return a.grade < b.grade; };
+    mt19937 rng(17);
+    
+    cout << "ns per array (ns per key), " << totalKeys << " keys per size, AVX2 "
+         << (cpuHasAVX2() ? "available" : "not available") << endl;
+    cout << setw(28) << "n";
+    for (int n : sizes) cout << setw(15) << n;
+    cout << endl;
+    
+    vector<vector<string>> cells(7);
+    bool allOk = true;
+    for (int n : sizes) {
+        int arrays = max(1, totalKeys / n);
+        vector<GradeKey> input((size_t)arrays * n);
+        for (size_t i = 0; i < input.size(); i++) input[i] = {(rng() % 1001) / 10.0f, (uint32_t)(i % n)};
+        vector<GradeKey> expected = input;
+        for (int a = 0; a < arrays; a++) {
+            stable_sort(expected.begin() + (size_t)a * n, expected.begin() + (size_t)(a + 1) * n, plainLess);
+        }
+        
+        for (int method = 0; method < 7; method++) {
+            bool isKernel = method >= 1 && method <= 2;
+            if ((isKernel && n > (int)NETWORK_SORT_MAX) || (method == 2 && !cpuHasAVX2())) {
+                cells[method].push_back("-");
+                continue;
+            }
+            vector<GradeKey> work = input;
+            auto start = chrono::steady_clock::now();
+            for (int a = 0; a < arrays; a++) {
+                size_t lo = (size_t)a * n, hi = lo + n;
+                switch (method) {
+                    case 0: insertionSortRange(work, lo, hi, plainLess); break;
+                    case 1: networkSortGradeKeys(&work[lo], n, false); break;
+                    case 2: networkSortGradeKeys(&work[lo], n, true); break;
+                    case 3: introSortBy(work, lo, hi, plainLess); break;
+                    case 4: introSortBy(work, lo, hi, GradeLess()); break;
+                    case 5: naturalMergeSortBy(work, lo, hi, plainLess); break;
+                    case 6: naturalMergeSortBy(work, lo, hi, GradeLess()); break;
+                }
+            }
+            double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / arrays;
+            
+            // introsort is not stable, so it only has to match the grades
+            bool ok = true;
+            for (size_t i = 0; ok && i < work.size(); i++) {
+                ok = work[i].grade == expected[i].grade
+                     && (method == 3 || method == 4 || work[i].index == expected[i].index);
+            }
+            allOk = allOk && ok;
+            ostringstream cell;
+            cell << fixed << setprecision(0) << ns << " (" << setprecision(1) << ns / n << ")" << (ok ? "" : "!");
+            cells[method].push_back(cell.str());
+        }
+    }
+    for (int method = 0; method < 7; method++) {
+        cout << setw(28) << names[method];
+        for (size_t i = 0; i < cells[method].size(); i++) cout << setw(15) << cells[method][i];
+        cout << endl;
+    }
+    cout << (allOk ? "all results match std::stable_sort" : "MISMATCH (marked !)") << endl;
+}
+
+// Name queries at registrar scale: index against the linear scans it
+// replaces (== for exact, edit distance on every name for fuzzy).
+void benchNames(int n) {
+    mt19937 rng(12);
+    const char* syl[] = {"ka", "ra", "an", "vi", "sh", "ma", "ne", "li", "to", "ru", "de", "po",
+                         "ya", "mi", "sa", "jo", "el", "ha", "ti", "no", "be", "ga", "ol", "ar"};
+    auto word = [&](int parts) {
+        string w;
+        for (int i = 0; i < parts; i++) w += syl[rng() % 24];
+        w[0] = toupper(w[0]);
+        return w;
+    };
+    vector<string> names(n);
+    for (int i = 0; i < n; i++) names[i] = word(2 + rng() % 2) + " " + word(2 + rng() % 3);
+    
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    NameIndex index;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) index.add(names[i], i);
+    index.prefix("", 0);  // sort once outside the timed queries
+    double buildMs = ms(start);
+    
+    // queries: existing names, and the same names with two random typos
+    int q = 200;
+    vector<string> exactQ(q), typoQ(q);
+    for (int i = 0; i < q; i++) {
+        exactQ[i] = names[rng() % n];
+        string t = exactQ[i];
+        for (int e = 0; e < 2; e++) {
+            size_t pos = 1 + rng() % (t.size() - 1);
+            if (rng() % 2) t[pos] = 'a' + rng() % 26;
+            else t.erase(pos, 1);
+        }
+        typoQ[i] = t;
+    }
+    
+    long linHits = 0, idxHits = 0;
+    start = chrono::steady_clock::now();
+    for (auto& name : exactQ)
+        for (int i = 0; i < n; i++) linHits += names[i] == name;
+    double linExact = ms(start);
+    start = chrono::steady_clock::now();
+    for (auto& name : exactQ) idxHits += index.exact(name).size();
+    double idxExact = ms(start);
+    
+    long prefixHits = 0;
+    start = chrono::steady_clock::now();
+    for (auto& name : exactQ) prefixHits += index.prefix(name.substr(0, 4), 100).size();
+    double idxPrefix = ms(start);
+    
+    long fuzzyHits = 0, found = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < q; i++) {
+        vector<pair<int, int>> r = index.fuzzy(typoQ[i], 2, 1000000);
+        fuzzyHits += r.size();
+        for (auto& m : r) if (names[m.first] == exactQ[i]) { found++; break; }
+    }
+    double idxFuzzy = ms(start);
+    
+    // linear fuzzy scan on the first few queries only, it is slow
+    int linQ = 5;
+    long linFuzzyHits = 0, idxFuzzySub = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < linQ; i++) {
+        string fq = typoQ[i];
+        for (char& c : fq) c = tolower((unsigned char)c);
+        for (int k = 0; k < n; k++) {
+            string f = names[k];
+            for (char& c : f) c = tolower((unsigned char)c);
+            if (abs((int)f.size() - (int)fq.size()) > 2) continue;
+            vector<int> prev(f.size() + 1), cur(f.size() + 1);
+            for (size_t j = 0; j <= f.size(); j++) prev[j] = j;
+            for (size_t a = 1; a <= fq.size(); a++) {
+                cur[0] = a;
+                for (size_t b = 1; b <= f.size(); b++)
+                    cur[b] = min(min(prev[b] + 1, cur[b - 1] + 1), prev[b - 1] + (fq[a - 1] != f[b - 1]));
+                swap(prev, cur);
+            }
+            linFuzzyHits += prev[f.size()] <= 2;
+        }
+    }
+    double linFuzzy = ms(start) / linQ;
+    for (int i = 0; i < linQ; i++) idxFuzzySub += index.fuzzy(typoQ[i], 2, 1000000).size();
+    
+    cout << n << " students, " << index.distinctNames() << " distinct names, index built in " << buildMs << " ms" << endl;
+    cout << "Per query (ms):" << endl;
+    cout << "  exact   linear " << linExact / q << "   index " << idxExact / q
+         << (linHits == idxHits ? "   (same hits)" : "   (MISMATCH)") << endl;
+    cout << "  prefix  index " << idxPrefix / q << "   (" << prefixHits / q << " hits on average, 4-letter prefix)" << endl;
+    cout << "  fuzzy   linear " << linFuzzy << "   index " << idxFuzzy / q
+         << (linFuzzyHits == idxFuzzySub ? "   (same hits)" : "   (MISMATCH)") << endl;
+    cout << "  two-typo queries that found the original name: " << found << "/" << q << endl;
+}
+
+// Object-moving sorts against indirect ones (sort the keys, then either
+// permute the records once or just keep the order) for the O(n log n)
+// algorithms and radix sort; bubble and insertion sort are quadratic at
+// these sizes.
+void benchIndirect(int maxN) {
+    StudentPerformanceTracker t;
+    const char* names[] = {"", "", "", "Merge Sort", "Quick Sort", "Heap Sort", "Radix Sort"};
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    cout << setw(10) << "n" << setw(12) << "algorithm" << setw(14) << "records ms"
+         << setw(16) << "keys+permute ms" << setw(14) << "order only ms" << endl;
+    for (int n = 100000; n <= maxN; n *= 10) {
+        vector<Student> students = makeStudents(n, 5);
+        mt19937 rng(n);
+        // finer grades than the sample data, so the timings are not
+        // dominated by long runs of equal keys
+        for (Student& s : students) s.grade = (rng() % 10000001) / 100000.0f;
+        for (int choice = 3; choice <= 6; choice++) {
+            vector<Student> byRecords = students;
+            auto start = chrono::steady_clock::now();
+            t.runSort(byRecords, choice);
+            double recordsMs = ms(start);
+            
+            vector<Student> byKeys = students;
+            start = chrono::steady_clock::now();
+            t.sortIndirect(byKeys, choice);
+            double keysMs = ms(start);
+            
+            start = chrono::steady_clock::now();
+            vector<uint32_t> order = t.sortedOrder(students, choice);
+            double orderMs = ms(start);
+            
+            bool same = true;
+            for (int i = 0; i < n && same; i++) {
+                same = byRecords[i].studentID == byKeys[i].studentID
+                       && byRecords[i].studentID == students[order[i]].studentID;
+            }
+            cout << setw(10) << n << setw(12) << names[choice] << setw(14) << recordsMs
+                 << setw(16) << keysMs << setw(14) << orderMs << (same ? "" : "  MISMATCH") << endl;
+        }
+    }
+}
+
+// Sequential merge and quick sort against the parallel versions on pools
+// of 1 .. maxThreads threads (doubling), sorting (grade, index) keys. The
+// parallel merge sort must give exactly mergeSort's order; the parallel
+// quicksort is stable, so it must give that same order too, and the same
+// grade sequence as quickSort.
+void benchParallel(int n, unsigned maxThreads) {
+    StudentPerformanceTracker t;
+    mt19937 rng(n);
+    vector<GradeKey> keys(n);
+    for (int i = 0; i < n; i++) keys[i] = {(rng() % 10000001) / 100000.0f, (uint32_t)i};
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    
+    vector<GradeKey> byMerge = keys;
+    auto start = chrono::steady_clock::now();
+    t.mergeSort(byMerge, 0, n - 1);
+    double mergeMs = ms(start);
+    vector<GradeKey> byQuick = keys;
+    start = chrono::steady_clock::now();
+    t.quickSort(byQuick, 0, n - 1);
+    double quickMs = ms(start);
+    
+    cout << "n = " << n << ", hardware threads: " << thread::hardware_concurrency() << endl;
+    cout << "sequential mergeSort " << mergeMs << " ms, quickSort " << quickMs << " ms" << endl;
+    cout << setw(8) << "threads" << setw(12) << "merge ms" << setw(9) << "speedup"
+         << setw(12) << "quick ms" << setw(9) << "speedup" << endl;
+    vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+    for (size_t c = 0; c < counts.size(); c++) {
+        unsigned threads = counts[c];
+        ThreadPool pool(threads);
+        vector<GradeKey> pm = keys;
+        start = chrono::steady_clock::now();
+        t.parallelMergeSort(pm, pool);
+        double pmMs = ms(start);
+        vector<GradeKey> pq = keys;
+        start = chrono::steady_clock::now();
+        t.parallelQuickSort(pq, pool);
+        double pqMs = ms(start);
+        
+        bool same = true;
+        for (int i = 0; i < n && same; i++) {
+            same = pm[i].index == byMerge[i].index && pq[i].index == byMerge[i].index
+                   && pq[i].grade == byQuick[i].grade;
+        }
+        cout << setw(8) << threads << setw(12) << pmMs << setw(9) << mergeMs / pmMs
+             << setw(12) << pqMs << setw(9) << quickMs / pqMs << (same ? "" : "  MISMATCH") << endl;
+    }
+}
+
+// Number of operator new calls so far (vectors, strings, everything), for
+// --bench-mergesort. The global operators are only replaced in a bench
+// build (g++ -DCOUNT_ALLOCATIONS ...), so the normal program keeps the
+// standard ones. They are kept out of line, otherwise g++ sees the inlined
+// malloc()/free() next to new/delete and warns about a mismatch.
+#ifdef COUNT_ALLOCATIONS
+const bool countingAllocations = true;
+static atomic<size_t> heapAllocations(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    heapAllocations++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new(size_t size, const nothrow_t&) noexcept {
+    heapAllocations++;
+    return malloc(size ? size : 1);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { free(p); }
+#else
+const bool countingAllocations = false;
+static const size_t heapAllocations = 0;
+#endif
+
+// The old mergeSort: top-down, and every merge copies both halves into two
+// new vectors. Kept only as the baseline for --bench-mergesort.
+template <class T>
+void allocatingMerge(vector<T>& arr, int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+    
+    vector<T> leftArr(n1), rightArr(n2);
+    
+    for (int i = 0; i < n1; i++)
+        leftArr[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        rightArr[j] = arr[mid + 1 + j];
+    
+    int i = 0, j = 0, k = left;
+    
+    while (i < n1 && j < n2) {
+        if (gradeOf(leftArr[i]) <= gradeOf(rightArr[j])) {
+            arr[k] = leftArr[i];
+            i++;
+        } else {
+            arr[k] = rightArr[j];
+            j++;
+        }
+        k++;
+    }
+    
+    while (i < n1) {
+        arr[k] = leftArr[i];
+        i++;
+        k++;
+    }
+    
+    while (j < n2) {
+        arr[k] = rightArr[j];
+        j++;
+        k++;
+    }
+}
+
+template <class T>
+void allocatingMergeSort(vector<T>& arr, int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+        
+        allocatingMergeSort(arr, left, mid);
+        allocatingMergeSort(arr, mid + 1, right);
+        allocatingMerge(arr, left, mid, right);
+    }
+}
+
+// Old and new mergeSort on shuffled and on already sorted records and
+// (grade, index) keys: time and, in a COUNT_ALLOCATIONS build, number of
+// heap allocations. Both sorts are stable, so the results must be identical.
+void benchMergeSort(int n) {
+    StudentPerformanceTracker t;
+    vector<Student> students = makeStudents(n, 11);
+    vector<GradeKey> keys(n);
+    for (int i = 0; i < n; i++) keys[i] = {students[i].grade, (uint32_t)i};
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    cout << "n = " << n << endl;
+    cout << setw(18) << "input" << setw(12) << "old ms" << setw(14) << "old allocs"
+         << setw(12) << "new ms" << setw(14) << "new allocs" << endl;
+    for (int sorted = 0; sorted <= 1; sorted++) {
+        for (int records = 1; records >= 0; records--) {
+            double oldMs, newMs;
+            size_t oldAllocs, newAllocs;
+            bool same = true;
+            if (records) {
+                vector<Student> a = students, b = students;
+                if (sorted) {
+                    t.mergeSort(a, 0, n - 1);
+                    b = a;
+                }
+                size_t before = heapAllocations;
+                auto start = chrono::steady_clock::now();
+                allocatingMergeSort(a, 0, n - 1);
+                oldMs = ms(start);
+                oldAllocs = heapAllocations - before;
+                before = heapAllocations;
+                start = chrono::steady_clock::now();
+                t.mergeSort(b, 0, n - 1);
+                newMs = ms(start);
+                newAllocs = heapAllocations - before;
+                for (int i = 0; i < n && same; i++) same = a[i].studentID == b[i].studentID;
+            } else {
+                vector<GradeKey> a = keys, b = keys;
+                if (sorted) {
+                    t.mergeSort(a, 0, n - 1);
+                    b = a;
+                }
+                size_t before = heapAllocations;
+                auto start = chrono::steady_clock::now();
+                allocatingMergeSort(a, 0, n - 1);
+                oldMs = ms(start);
+                oldAllocs = heapAllocations - before;
+                before = heapAllocations;
+                start = chrono::steady_clock::now();
+                t.mergeSort(b, 0, n - 1);
+                newMs = ms(start);
+                newAllocs = heapAllocations - before;
+                for (int i = 0; i < n && same; i++) same = a[i].index == b[i].index;
+            }
+            string input = string(sorted ? "sorted " : "random ") + (records ? "records" : "keys");
+            cout << setw(18) << input << setw(12) << oldMs << setw(14)
+                 << (countingAllocations ? to_string(oldAllocs) : "-") << setw(12) << newMs << setw(14)
+                 << (countingAllocations ? to_string(newAllocs) : "-") << (same ? "" : "  MISMATCH") << endl;
+        }
+    }
+    if (!countingAllocations) cout << "(build with -DCOUNT_ALLOCATIONS to count heap allocations)" << endl;
+}
+
+// The old quickSort: Lomuto partition with the last element as pivot.
+// Kept only as the baseline for --bench-quicksort.
+void lomutoQuickSort(vector<GradeKey>& arr, int low, int high) {
+    if (low < high) {
+        float pivot = arr[high].grade;
+        int i = low - 1;
+        for (int j = low; j < high; j++) {
+            if (arr[j].grade < pivot) {
+                i++;
+                swap(arr[i], arr[j]);
+            }
+        }
+        swap(arr[i + 1], arr[high]);
+        lomutoQuickSort(arr, low, i);
+        lomutoQuickSort(arr, i + 2, high);
+    }
+}
+
+// Lomuto quicksort against the introsort quickSort and std::sort on
+// random, sorted, reversed and duplicate-heavy grades. Lomuto is quadratic
+// (and recurses n deep) on all but random input, so there it only runs up
+// to 20000 keys.
+void benchQuickSort(int maxN) {
+    StudentPerformanceTracker t;
+    const char* dists[] = {"random", "sorted", "reversed", "10 grades"};
+    auto ms = [](chrono::steady_clock::time_point a) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - a).count();
+    };
+    cout << setw(10) << "n" << setw(11) << "input" << setw(13) << "lomuto ms"
+         << setw(13) << "introsort ms" << setw(13) << "std::sort ms" << endl;
+    for (int n = 20000; n <= maxN; n = n * 10 > maxN && n < maxN ? maxN : n * 10) {
+        for (int d = 0; d < 4; d++) {
+            mt19937 rng(n + d);
+            vector<GradeKey> keys(n);
+            for (int i = 0; i < n; i++) {
+                float grade = (rng() % 10000001) / 100000.0f;
+                if (d == 3) grade = 55 + 5 * (rng() % 10);
+                keys[i] = {grade, (uint32_t)i};
+            }
+            if (d == 1 || d == 2) {
+                sort(keys.begin(), keys.end(), [](const GradeKey& a, const GradeKey& b) { return a.grade < b.grade; });
+            }
+            if (d == 2) reverse(keys.begin(), keys.end());
+            
+            vector<GradeKey> byStd = keys;
+            auto start = chrono::steady_clock::now();
+            sort(byStd.begin(), byStd.end(), [](const GradeKey& a, const GradeKey& b) { return a.grade < b.grade; });
+            double stdMs = ms(start);
+            
+            vector<GradeKey> byIntro = keys;
+            start = chrono::steady_clock::now();
+            t.quickSort(byIntro, 0, n - 1);
+            double introMs = ms(start);
+            
+            bool same = true;
+            for (int i = 0; i < n && same; i++) same = byIntro[i].grade == byStd[i].grade;
+            
+            cout << setw(10) << n << setw(11) << dists[d];
+            if (d == 0 || n <= 20000) {
+                vector<GradeKey> byLomuto = keys;
+                start = chrono::steady_clock::now();
+                lomutoQuickSort(byLomuto, 0, n - 1);
+                cout << setw(13) << ms(start);
+            } else {
+                cout << setw(13) << "-";
+            }
+            cout << setw(13) << introMs << setw(13) << stdMs << (same ? "" : "  MISMATCH") << endl;
+        }
+    }
+}
+
+// External Sort
+// Sorts a file of fixed-size student records that need not fit in memory
+// (--external-sort). Phase 1 fills the memory budget with one large read,
+// sorts (key, position) pairs for those records with introSortBy and
+// writes the records out in that order as a sorted run. Phase 2 merges up
+// to fanIn runs at a time through a loser tree; every run has its own
+// input buffer refilled by large sequential reads and the output goes
+// through one buffer of the same size. When the budget cannot give every
+// run a buffer of at least MERGE_BUFFER_MIN bytes, runs are merged in
+// several passes. Equal keys keep their input order.
+struct DiskRecord {
+    int32_t id;
+    float grade;
+    char name[48];    // zero-terminated and zero-padded, longer names are cut
+    char course[40];
+};
+
+const size_t MERGE_BUFFER_MIN = 256 * 1024;
+const char* EXTERNAL_KEYS[] = {"id", "grade", "name"};
+
+DiskRecord toDisk(const Student& s) {
+    DiskRecord r;
+    memset(&r, 0, sizeof r);
+    r.id = s.studentID;
+    r.grade = s.grade;
+    strncpy(r.name, s.studentName.c_str(), sizeof r.name - 1);
+    strncpy(r.course, s.courseDetails.c_str(), sizeof r.course - 1);
+    return r;
+}
+
+// key: index into EXTERNAL_KEYS
+struct RecordLess {
+    int key;
+    bool operator()(const DiskRecord& a, const DiskRecord& b) const {
+        if (key == 0) return a.id < b.id;
+        if (key == 1) return a.grade < b.grade;
+        return strcmp(a.name, b.name) < 0;
+    }
+};
+
+// Per-phase I/O volume and time; ioSeconds is the part spent in reads
+// and writes
+struct PhaseStats {
+    string name;
+    size_t runsIn, runsOut;
+    unsigned long long bytesRead, bytesWritten;
+    double seconds, ioSeconds;
+};
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// up to max records, returns how many were read
+size_t readRecords(ifstream& in, DiskRecord* buf, size_t max, PhaseStats& stats) {
+    auto start = chrono::steady_clock::now();
+    in.read((char*)buf, max * sizeof(DiskRecord));
+    size_t got = in.gcount() / sizeof(DiskRecord);
+    stats.bytesRead += got * sizeof(DiskRecord);
+    stats.ioSeconds += secondsSince(start);
+    return got;
+}
+
+void writeRecords(ofstream& out, const DiskRecord* buf, size_t count, PhaseStats& stats) {
+    auto start = chrono::steady_clock::now();
+    out.write((const char*)buf, count * sizeof(DiskRecord));
+    stats.bytesWritten += count * sizeof(DiskRecord);
+    stats.ioSeconds += secondsSince(start);
+}
+
+// Order of records[0..n) by key, ties by position
+template <class K, class GetKey, class KeyLess>
+vector<pair<K, uint32_t>> runOrder(const DiskRecord* records, size_t n, GetKey get, KeyLess keyLess) {
+    vector<pair<K, uint32_t>> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = make_pair(get(records[i]), (uint32_t)i);
+    introSortBy(keys, 0, n, [keyLess](const pair<K, uint32_t>& a, const pair<K, uint32_t>& b) {
+        return keyLess(a.first, b.first) || (!keyLess(b.first, a.first) && a.second < b.second);
+    });
+    return keys;
+}
+
+// Writes records[0..n) in key order through out and writeBuf
+template <class K>
+void writeInOrder(ofstream& out, const DiskRecord* records, const vector<pair<K, uint32_t>>& order,
+                  vector<DiskRecord>& writeBuf, PhaseStats& stats) {
+    size_t used = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        writeBuf[used++] = records[order[i].second];
+        if (used == writeBuf.size()) {
+            writeRecords(out, writeBuf.data(), used, stats);
+            used = 0;
+        }
+    }
+    writeRecords(out, writeBuf.data(), used, stats);
+}
+
+// Order-independent checksum of a block of records, compared before and
+// after sorting by --check
+unsigned long long recordsChecksum(const DiskRecord* records, size_t n) {
+    unsigned long long sum = 0;
+    const size_t words = sizeof(DiskRecord) / 8;
+    for (size_t i = 0; i < n; i++) {
+        unsigned long long w[words];
+        memcpy(w, &records[i], sizeof w);
+        for (size_t j = 0; j < words; j++) sum += w[j] * (2 * j + 1);
+    }
+    return sum;
+}
+
+// Phase 1: sorted runs of at most runRecords records each, written to
+// prefix0, prefix1, ...; also counts the records and, if checksum is
+// given, adds up their checksum
+vector<string> formRuns(const string& input, const string& prefix, int key, size_t runRecords,
+                        size_t writeRecordsMax, PhaseStats& stats, size_t& total, unsigned long long* checksum) {
+    vector<string> runs;
+    ifstream in(input.c_str(), ios::binary);
+    vector<DiskRecord> records(runRecords);
+    vector<DiskRecord> writeBuf(writeRecordsMax);
+    auto start = chrono::steady_clock::now();
+    while (true) {
+        size_t n = readRecords(in, records.data(), runRecords, stats);
+        if (n == 0) break;
+        total += n;
+        if (checksum) *checksum += recordsChecksum(records.data(), n);
+        
+        runs.push_back(prefix + to_string(runs.size()));
+        ofstream out(runs.back().c_str(), ios::binary);
+        const DiskRecord* recs = records.data();
+        if (key == 0) {
+            writeInOrder(out, recs, runOrder<int32_t>(recs, n, [](const DiskRecord& r) { return r.id; },
+                                                        less<int32_t>()), writeBuf, stats);
+        } else if (key == 1) {
+            writeInOrder(out, recs, runOrder<float>(recs, n, [](const DiskRecord& r) { return r.grade; },
+                                                      less<float>()), writeBuf, stats);
+        } else {
+            writeInOrder(out, recs, runOrder<const char*>(recs, n, [](const DiskRecord& r) { return r.name; },
+                                                            [](const char* a, const char* b) { return strcmp(a, b) < 0; }),
+                         writeBuf, stats);
+        }
+        if (n < runRecords) break;
+    }
+    stats.runsOut = runs.size();
+    stats.seconds = secondsSince(start);
+    return runs;
+}
+
+// Loser tree over k sorted sources: tree[0] is the current winner and
+// every internal node holds the loser of the match played there, so when
+// the winner's source moves on only its path to the root is replayed,
+// about log2 k comparisons per record (a binary heap needs two per level).
+// beats(a, b) says whether source a's current element goes first.
+template <class Beats>
+class LoserTree {
+private:
+    vector<int> tree;
+    int k;
+    Beats beats;
+    
+    // leaves are k..2k-1, internal nodes 1..k-1
+    int build(int node) {
+        if (node >= k) return node - k;
+        int a = build(2 * node), b = build(2 * node + 1);
+        if (beats(a, b)) {
+            tree[node] = b;
+            return a;
+        }
+        tree[node] = a;
+        return b;
+    }
+    
+public:
+    LoserTree(int k, Beats beats) : tree(k), k(k), beats(beats) {
+        tree[0] = build(1);
+    }
+    
+    int winner() const { return tree[0]; }
+    
+    // the winner's source has a new current element (or ran out)
+    void replay() {
+        int s = tree[0];
+        for (int t = (s + k) / 2; t > 0; t /= 2) {
+            if (beats(tree[t], s)) swap(tree[t], s);
+        }
+        tree[0] = s;
+    }
+};
+
+// One run being merged: its input buffer and the position in it
+struct RunReader {
+    ifstream in;
+    vector<DiskRecord> buf;
+    size_t pos, count;
+    
+    bool exhausted() const { return pos == count; }
+    const DiskRecord& current() const { return buf[pos]; }
+    
+    void advance(PhaseStats& stats) {
+        if (++pos == count) {
+            count = readRecords(in, buf.data(), buf.size(), stats);
+            pos = 0;
+        }
+    }
+};
+
+struct RunBeats {
+    deque<RunReader>* readers;
+    RecordLess less;
+    
+    // exhausted runs lose every match, ties go to the earlier run
+    bool operator()(int a, int b) const {
+        const RunReader& ra = (*readers)[a];
+        const RunReader& rb = (*readers)[b];
+        if (ra.exhausted()) return false;
+        if (rb.exhausted()) return true;
+        if (less(ra.current(), rb.current())) return true;
+        if (less(rb.current(), ra.current())) return false;
+        return a < b;
+    }
+};
+
+// Phase 2 step: k-way merge of runs into output, bufRecords per buffer
+void mergeRunFiles(const vector<string>& runs, const string& output, int key, size_t bufRecords,
+                   PhaseStats& stats) {
+    deque<RunReader> readers(runs.size());
+    for (size_t i = 0; i < runs.size(); i++) {
+        RunReader& r = readers[i];
+        r.in.open(runs[i].c_str(), ios::binary);
+        r.buf.resize(bufRecords);
+        r.pos = 0;
+        r.count = readRecords(r.in, r.buf.data(), bufRecords, stats);
+    }
+    RunBeats beats = {&readers, RecordLess{key}};
+    LoserTree<RunBeats> tree(runs.size(), beats);
+    
+    ofstream out(output.c_str(), ios::binary);
+    vector<DiskRecord> writeBuf(bufRecords);
+    size_t used = 0;
+    while (!readers[tree.winner()].exhausted()) {
+        RunReader& r = readers[tree.winner()];
+        writeBuf[used++] = r.current();
+        if (used == writeBuf.size()) {
+            writeRecords(out, writeBuf.data(), used, stats);
+            used = 0;
+        }
+        r.advance(stats);
+        tree.replay();
+    }
+    writeRecords(out, writeBuf.data(), used, stats);
+}
+
+// Sorted-order and content check of the output: one more sequential pass
+bool checkSorted(const string& path, int key, size_t expected, unsigned long long checksum) {
+    ifstream in(path.c_str(), ios::binary);
+    PhaseStats ignored = {"", 0, 0, 0, 0, 0, 0};
+    vector<DiskRecord> buf(1 << 14);
+    RecordLess less = {key};
+    DiskRecord prev;
+    size_t total = 0;
+    unsigned long long sum = 0;
+    bool sorted = true;
+    size_t n;
+    while ((n = readRecords(in, buf.data(), buf.size(), ignored)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (total + i > 0 && less(buf[i], prev)) sorted = false;
+            prev = buf[i];
+        }
+        sum += recordsChecksum(buf.data(), n);
+        total += n;
+    }
+    return sorted && total == expected && sum == checksum;
+}
+
+// --make-archive FILE N [seed]: N random student records, written in
+// chunks so N is not limited by memory
+int makeArchive(int argc, char* argv[]) {
+    if (argc < 4) {
+        cout << "usage: --make-archive FILE N [seed]" << endl;
+        return 1;
+    }
+    long long n = atoll(argv[3]);
+    unsigned seed = argc > 4 ? atoi(argv[4]) : 1;
+    ofstream out(argv[2], ios::binary);
+    mt19937 rng(seed);
+    const int chunk = 1 << 16;
+    vector<DiskRecord> buf;
+    for (long long done = 0; done < n; done += chunk) {
+        int count = (int)min<long long>(chunk, n - done);
+        vector<Student> students = makeStudents(count, seed + done);
+        buf.resize(count);
+        for (int i = 0; i < count; i++) {
+            students[i].studentID = 100000 + rng() % 900000000;
+            buf[i] = toDisk(students[i]);
+        }
+        out.write((const char*)buf.data(), count * sizeof(DiskRecord));
+    }
+    cout << n << " records (" << n * sizeof(DiskRecord) / 1048576.0 << " MB) written to " << argv[2] << endl;
+    return out ? 0 : 1;
+}
+
+// --external-sort IN OUT [--key id|grade|name] [--memory MB] [--check]
+int externalSort(int argc, char* argv[]) {
+    if (argc < 4) {
+        cout << "usage: --external-sort IN OUT [--key id|grade|name] [--memory MB] [--check]" << endl;
+        return 1;
+    }
+    string input = argv[2], output = argv[3];
+    int key = 1;
+    size_t budget = 64 << 20;
+    bool check = false;
+    for (int a = 4; a < argc; a++) {
+        string opt = argv[a];
+        if (opt == "--check") {
+            check = true;
+        } else if (opt == "--memory" && a + 1 < argc) {
+            budget = max(1.0, atof(argv[++a])) * 1048576;
+        } else if (opt == "--key" && a + 1 < argc) {
+            string name = argv[++a];
+            key = -1;
+            for (int k = 0; k < 3; k++) {
+                if (name == EXTERNAL_KEYS[k]) key = k;
+            }
+            if (key < 0) {
+                cout << "Unknown key: " << name << " (id, grade or name)" << endl;
+                return 1;
+            }
+        } else {
+            cout << "Unknown option: " << opt << endl;
+            return 1;
+        }
+    }
+    if (!ifstream(input.c_str(), ios::binary)) {
+        cout << "Cannot open " << input << endl;
+        return 1;
+    }
+    
+    // phase 1: an eighth of the budget for the write buffer, the rest for
+    // records plus their (key, position) pairs
+    size_t writeBufRecords = max<size_t>(1, budget / 8 / sizeof(DiskRecord));
+    size_t runRecords = max<size_t>(1, (budget - writeBufRecords * sizeof(DiskRecord))
+                                           / (sizeof(DiskRecord) + sizeof(pair<const char*, uint32_t>)));
+    // phase 2: fanIn input buffers plus one output buffer
+    size_t fanIn = max<size_t>(2, budget / MERGE_BUFFER_MIN - 1);
+    
+    vector<PhaseStats> phases;
+    PhaseStats first = {"run formation", 0, 0, 0, 0, 0, 0};
+    size_t total = 0;
+    unsigned long long checksum = 0;
+    vector<string> runs = formRuns(input, output + ".run0.", key, runRecords, writeBufRecords, first,
+                                   total, check ? &checksum : nullptr);
+    first.runsIn = 1;
+    phases.push_back(first);
+    
+    for (int pass = 1; runs.size() > 1; pass++) {
+        PhaseStats stats = {"merge pass " + to_string(pass), runs.size(), 0, 0, 0, 0, 0};
+        auto start = chrono::steady_clock::now();
+        vector<string> next;
+        for (size_t g = 0; g < runs.size(); g += fanIn) {
+            vector<string> group(runs.begin() + g, runs.begin() + min(runs.size(), g + fanIn));
+            bool last = group.size() == runs.size();
+            next.push_back(last ? output : output + ".run" + to_string(pass) + "." + to_string(next.size()));
+            size_t bufRecords = max<size_t>(1, budget / (group.size() + 1) / sizeof(DiskRecord));
+            mergeRunFiles(group, next.back(), key, bufRecords, stats);
+            for (size_t i = 0; i < group.size(); i++) remove(group[i].c_str());
+        }
+        stats.runsOut = next.size();
+        stats.seconds = secondsSince(start);
+        phases.push_back(stats);
+        runs.swap(next);
+    }
+    // a single run (or none) is already the answer
+    if (runs.empty()) {
+        ofstream(output.c_str(), ios::binary);
+    } else if (runs[0] != output) {
+        remove(output.c_str());
+        rename(runs[0].c_str(), output.c_str());
+    }
+    
+    cout << "external sort of " << total << " records (" << sizeof(DiskRecord) << " bytes each) by "
+         << EXTERNAL_KEYS[key] << ", memory budget " << budget / 1048576.0 << " MB, " << runRecords
+         << " records per run, fan-in " << fanIn << endl;
+    cout << fixed << setprecision(2);
+    cout << setw(15) << "phase" << setw(9) << "runs in" << setw(10) << "runs out" << setw(11) << "read MB"
+         << setw(12) << "written MB" << setw(9) << "time s" << setw(8) << "I/O s" << endl;
+    PhaseStats sum = {"total", 0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i <= phases.size(); i++) {
+        const PhaseStats& p = i < phases.size() ? phases[i] : sum;
+        if (i < phases.size()) {
+            sum.bytesRead += p.bytesRead;
+            sum.bytesWritten += p.bytesWritten;
+            sum.seconds += p.seconds;
+            sum.ioSeconds += p.ioSeconds;
+        }
+        cout << setw(15) << p.name;
+        if (i < phases.size()) cout << setw(9) << p.runsIn << setw(10) << p.runsOut;
+        else cout << setw(19) << "";
+        cout << setw(11) << p.bytesRead / 1048576.0 << setw(12) << p.bytesWritten / 1048576.0 << setw(9) << p.seconds
+             << setw(8) << p.ioSeconds << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    if (check) {
+        bool ok = checkSorted(output, key, total, checksum);
+        cout << "check: " << (ok ? "sorted, same records" : "FAILED") << endl;
+        if (!ok) return 1;
+    }
+    return 0;
+}
+
+// Sorting benchmark harness (--bench-sorts). Every algorithm from the sort
+// menu on every size and input order, warmup plus repeated trials, median
+// and minimum with a 95% interval for the median; optional comparison and
+// move counts; optional CSV and JSON output for tracking results over time.
+//   --sizes 10,1000,...      default 10, 100, ..., 10^7
+//   --dists random,sorted,reversed,few-unique,organ-pipe   (default: all)
+//   --algos bubble,insertion,merge,quick,heap,radix         (default: all)
+//   --trials K --warmup W    default 7 and 1
+//   --quadratic-max N        largest size for bubble/insertion, default 10^4
+//   --records                sort Student records instead of (grade, index)
+//   --count                  also count comparisons and moves
+//   --csv FILE --json FILE
+const char* BENCH_DISTS[] = {"random", "sorted", "reversed", "few-unique", "organ-pipe"};
+const char* BENCH_ALGOS[] = {"", "bubble", "insertion", "merge", "quick", "heap", "radix"};
+
+// n grades in the given input order (index into BENCH_DISTS)
+vector<float> benchGrades(int n, int dist, unsigned seed) {
+    mt19937 rng(seed);
+    vector<float> grades(n);
+    for (int i = 0; i < n; i++) {
+        grades[i] = dist == 3 ? 55 + 5 * (rng() % 10) : (rng() % 10000001) / 100000.0f;
+    }
+    if (dist == 1 || dist == 2 || dist == 4) sort(grades.begin(), grades.end());
+    if (dist == 2) reverse(grades.begin(), grades.end());
+    if (dist == 4) {
+        // rising through the even positions, falling through the odd ones
+        vector<float> pipe;
+        pipe.reserve(n);
+        for (int i = 0; i < n; i += 2) pipe.push_back(grades[i]);
+        for (int i = n - 1 - n % 2; i > 0; i -= 2) pipe.push_back(grades[i]);
+        grades.swap(pipe);
+    }
+    return grades;
+}
+
+vector<string> splitList(const string& list) {
+    vector<string> items;
+    string item;
+    istringstream in(list);
+    while (getline(in, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int benchSorts(int argc, char* argv[]) {
+    vector<long long> sizes;
+    vector<int> dists, algos;
+    int trials = 7, warmups = 1;
+    long long quadraticMax = 10000;
+    bool records = false, count = false;
+    string csvPath, jsonPath;
+    
+    for (int a = 2; a < argc; a++) {
+        string opt = argv[a];
+        bool hasValue = a + 1 < argc;
+        if (opt == "--records") records = true;
+        else if (opt == "--count") count = true;
+        else if (opt == "--sizes" && hasValue) {
+            vector<string> items = splitList(argv[++a]);
+            for (size_t i = 0; i < items.size(); i++) sizes.push_back(atoll(items[i].c_str()));
+        } else if ((opt == "--dists" || opt == "--algos") && hasValue) {
+            vector<string> items = splitList(argv[++a]);
+            const char** known = opt == "--dists" ? BENCH_DISTS : BENCH_ALGOS;
+            int first = opt == "--dists" ? 0 : 1, last = opt == "--dists" ? 4 : 6;
+            for (size_t i = 0; i < items.size(); i++) {
+                int found = -1;
+                for (int k = first; k <= last; k++) {
+                    if (items[i] == known[k]) found = k;
+                }
+                if (found < 0) {
+                    cout << "Unknown " << opt.substr(2) << " entry: " << items[i] << endl;
+                    return 1;
+                }
+                (opt == "--dists" ? dists : algos).push_back(found);
+            }
+        } else if (opt == "--trials" && hasValue) trials = max(1, atoi(argv[++a]));
+        else if (opt == "--warmup" && hasValue) warmups = max(0, atoi(argv[++a]));
+        else if (opt == "--quadratic-max" && hasValue) quadraticMax = atoll(argv[++a]);
+        else if (opt == "--csv" && hasValue) csvPath = argv[++a];
+        else if (opt == "--json" && hasValue) jsonPath = argv[++a];
+        else {
+            cout << "Unknown option: " << opt << endl;
+            return 1;
+        }
+    }
+    if (sizes.empty()) {
+        for (long long n = 10; n <= 10000000; n *= 10) sizes.push_back(n);
+    }
+    if (dists.empty()) {
+        for (int d = 0; d < 5; d++) dists.push_back(d);
+    }
+    if (algos.empty()) {
+        for (int c = 1; c <= 6; c++) algos.push_back(c);
+    }
+    
+    ofstream csv, json;
+    if (!csvPath.empty()) {
+        csv.open(csvPath.c_str());
+        csv << "n,distribution,algorithm,element,trials,median_ms,min_ms,ci_low_ms,ci_high_ms,comparisons,moves\n";
+    }
+    if (!jsonPath.empty()) {
+        json.open(jsonPath.c_str());
+        json << "{\n  \"element\": \"" << (records ? "record" : "key") << "\",\n  \"warmup\": " << warmups
+             << ",\n  \"results\": [";
+    }
+    
+    StudentPerformanceTracker t;
+    cout << "element: " << (records ? "Student record" : "(grade, index) key") << ", " << warmups
+         << " warmup + " << trials << " trials, times in ms, CI = 95% interval for the median" << endl;
+    cout << fixed << setprecision(4);
+    cout << setw(9) << "n" << setw(12) << "input" << setw(11) << "algorithm" << setw(7) << "trials"
+         << setw(12) << "median" << setw(12) << "min" << setw(25) << "CI";
+    if (count) cout << setw(15) << "comparisons" << setw(15) << "moves";
+    cout << endl;
+    
+    bool firstJson = true;
+    for (size_t si = 0; si < sizes.size(); si++) {
+        int n = sizes[si];
+        for (size_t di = 0; di < dists.size(); di++) {
+            vector<float> grades = benchGrades(n, dists[di], n * 7 + dists[di]);
+            vector<GradeKey> keys;
+            vector<Student> students;
+            if (records) {
+                students = makeStudents(n, n);
+                for (int i = 0; i < n; i++) students[i].grade = grades[i];
+            } else {
+                keys.resize(n);
+                for (int i = 0; i < n; i++) keys[i] = {grades[i], (uint32_t)i};
+            }
+            for (size_t ai = 0; ai < algos.size(); ai++) {
+                int choice = algos[ai];
+                if (choice <= 2 && n > quadraticMax) continue;
+                SortTiming timing;
+                if (records) {
+                    timing = measureSort(students, [&t, choice](vector<Student>& v) { t.runSort(v, choice); }, warmups, trials);
+                } else {
+                    timing = measureSort(keys, [&t, choice](vector<GradeKey>& v) { t.runSort(v, choice); }, warmups, trials);
+                }
+                SortCounters ops = {0, 0};
+                if (count) ops = countSortOps(grades, [&t, choice](vector<CountedKey>& v) { t.runSort(v, choice); });
+                
+                ostringstream ci;
+                ci << fixed << setprecision(4) << timing.ciLow << " - " << timing.ciHigh;
+                cout << setw(9) << n << setw(12) << BENCH_DISTS[dists[di]] << setw(11) << BENCH_ALGOS[choice]
+                     << setw(7) << timing.trials << setw(12) << timing.median << setw(12) << timing.min
+                     << setw(25) << ci.str();
+                if (count) cout << setw(15) << ops.comparisons << setw(15) << ops.moves;
+                cout << endl;
+                
+                if (csv.is_open()) {
+                    csv << n << ',' << BENCH_DISTS[dists[di]] << ',' << BENCH_ALGOS[choice] << ','
+                        << (records ? "record" : "key") << ',' << timing.trials << ',' << timing.median << ','
+                        << timing.min << ',' << timing.ciLow << ',' << timing.ciHigh << ',';
+                    if (count) csv << ops.comparisons << ',' << ops.moves;
+                    else csv << ',';
+                    csv << '\n';
+                }
+                if (json.is_open()) {
+                    json << (firstJson ? "\n" : ",\n") << "    {\"n\": " << n << ", \"distribution\": \""
+                         << BENCH_DISTS[dists[di]] << "\", \"algorithm\": \"" << BENCH_ALGOS[choice]
+                         << "\", \"trials\": " << timing.trials << ", \"median_ms\": " << timing.median
+                         << ", \"min_ms\": " << timing.min << ", \"ci_ms\": [" << timing.ciLow << ", "
+                         << timing.ciHigh << "]";
+                    if (count) json << ", \"comparisons\": " << ops.comparisons << ", \"moves\": " << ops.moves;
+                    json << "}";
+                    firstJson = false;
+                }
+            }
+        }
+    }
+    if (json.is_open()) json << "\n  ]\n}\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    return 0;
+}
+
+// Main function
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench-sorts") {
+        return benchSorts(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--make-archive") {
+        return makeArchive(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--external-sort") {
+        return externalSort(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-mergesort") {
+        benchMergeSort(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-quicksort") {
+        benchQuickSort(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-parallel") {
+        benchParallel(argc > 2 ? atoi(argv[2]) : 10000000,
+                      argc > 3 ? atoi(argv[3]) : max(1u, thread::hardware_concurrency()));
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-indirect") {
+        benchIndirect(argc > 2 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-small") {
+        benchSmallSorts(argc > 2 ? atoi(argv[2]) : 1 << 20);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-rank") {
+        benchRank(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-names") {
+        benchNames(argc > 2 ? atoi(argv[2]) : 2000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-search") {
+        benchSearch(argc > 2 ? atoi(argv[2]) : 1000000, argc > 3 ? atoi(argv[3]) : 5000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-hash") {
+        benchHashTable(argc > 2 ? atoi(argv[2]) : 50000);
+        return 0;
+    }
+    
     StudentPerformanceTracker tracker;
     int choice;
     
@@ -570,6 +3391,7 @@ int main() {
                 cout << "3. Merge Sort" << endl;
                 cout << "4. Quick Sort" << endl;
                 cout << "5. Heap Sort" << endl;
+                cout << "6. Radix Sort (LSD)" << endl;
                 cout << "Enter sorting choice: ";
                 int sortChoice;
                 cin >> sortChoice;
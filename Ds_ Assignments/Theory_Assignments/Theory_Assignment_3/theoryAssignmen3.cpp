@@ -6,6 +6,17 @@
 #include <queue>
 #include <stack>
 #include <cmath>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
@@ -199,6 +210,175 @@ public:
     }
 };
 
+// ==================== NAME INDEX ====================
+
+// Copy of NameIndex in labAssignment3.cpp, documented there; the handles
+// are roll numbers.
+class NameIndex {
+private:
+    vector<string> names;                // distinct names as entered
+    vector<string> folded;               // lower-case, for prefix and fuzzy
+    vector<vector<int>> handles;         // per name id
+    unordered_map<string, uint32_t> byName;
+    unordered_map<uint32_t, vector<uint32_t>> postings;  // trigram -> name ids
+    vector<vector<uint32_t>> byLength;   // folded length -> name ids
+    vector<uint32_t> sortedIds;          // by folded name, rebuilt lazily
+    size_t sortedUpTo;                   // names covered by sortedIds
+    vector<uint16_t> hits;               // per name id, scratch for fuzzy
+    
+    static string fold(const string& s) {
+        string f = s;
+        for(char& c : f) c = tolower((unsigned char)c);
+        return f;
+    }
+    
+    // distinct trigrams of "$$" + s + "$$"
+    static vector<uint32_t> trigrams(const string& s) {
+        string p = "$$" + s + "$$";
+        vector<uint32_t> g;
+        for(size_t i = 0; i + 3 <= p.size(); i++) {
+            g.push_back((uint32_t)(unsigned char)p[i] << 16 | (uint32_t)(unsigned char)p[i + 1] << 8
+                        | (unsigned char)p[i + 2]);
+        }
+        sort(g.begin(), g.end());
+        g.erase(unique(g.begin(), g.end()), g.end());
+        return g;
+    }
+    
+    // Levenshtein distance if it is <= k, otherwise k + 1
+    static int boundedDistance(const string& a, const string& b, int k) {
+        int n = a.size(), m = b.size();
+        if(abs(n - m) > k) return k + 1;
+        vector<int> prev(m + 1), cur(m + 1);
+        for(int j = 0; j <= m; j++) prev[j] = j;
+        for(int i = 1; i <= n; i++) {
+            cur[0] = i;
+            int rowMin = cur[0];
+            for(int j = 1; j <= m; j++) {
+                int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+                cur[j] = min(min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+                rowMin = min(rowMin, cur[j]);
+            }
+            if(rowMin > k) return k + 1;
+            swap(prev, cur);
+        }
+        return min(prev[m], k + 1);
+    }
+    
+    void sortNames() {
+        if(sortedUpTo == names.size()) return;
+        size_t mid = sortedIds.size();
+        for(size_t id = sortedUpTo; id < names.size(); id++) sortedIds.push_back(id);
+        auto less = [this](uint32_t x, uint32_t y) { return folded[x] < folded[y]; };
+        sort(sortedIds.begin() + mid, sortedIds.end(), less);
+        inplace_merge(sortedIds.begin(), sortedIds.begin() + mid, sortedIds.end(), less);
+        sortedUpTo = names.size();
+    }
+    
+public:
+    NameIndex() {
+        sortedUpTo = 0;
+    }
+    
+    void add(const string& name, int handle) {
+        auto it = byName.find(name);
+        if(it != byName.end()) {
+            handles[it->second].push_back(handle);
+            return;
+        }
+        uint32_t id = names.size();
+        byName[name] = id;
+        names.push_back(name);
+        folded.push_back(fold(name));
+        handles.push_back({handle});
+        hits.push_back(0);
+        for(uint32_t g : trigrams(folded[id])) postings[g].push_back(id);
+        size_t len = folded[id].size();
+        if(byLength.size() <= len) byLength.resize(len + 1);
+        byLength[len].push_back(id);
+    }
+    
+    // the name itself stays indexed; it just stops matching once it has no handles
+    void remove(const string& name, int handle) {
+        auto it = byName.find(name);
+        if(it == byName.end()) return;
+        vector<int>& h = handles[it->second];
+        h.erase(std::remove(h.begin(), h.end(), handle), h.end());
+    }
+    
+    vector<int> exact(const string& name) {
+        auto it = byName.find(name);
+        if(it == byName.end()) return {};
+        return handles[it->second];
+    }
+    
+    // case-insensitive, in name order, at most limit handles
+    vector<int> prefix(const string& p, size_t limit) {
+        sortNames();
+        string fp = fold(p);
+        vector<int> out;
+        auto it = lower_bound(sortedIds.begin(), sortedIds.end(), fp,
+                              [this](uint32_t id, const string& key) { return folded[id] < key; });
+        for(; it != sortedIds.end() && out.size() < limit; ++it) {
+            if(folded[*it].compare(0, fp.size(), fp) != 0) break;
+            for(int h : handles[*it]) {
+                if(out.size() == limit) break;
+                out.push_back(h);
+            }
+        }
+        return out;
+    }
+    
+    // (handle, edit distance) for names within maxDist of query
+    // (case-insensitive), closest first, at most limit entries
+    vector<pair<int, int>> fuzzy(const string& query, int maxDist, size_t limit) {
+        string fq = fold(query);
+        vector<uint32_t> grams = trigrams(fq);
+        int need = (int)grams.size() - 3 * maxDist;
+        vector<uint32_t> candidates;
+        if(need > 0) {
+            for(uint32_t g : grams) {
+                auto it = postings.find(g);
+                if(it == postings.end()) continue;
+                for(uint32_t id : it->second) {
+                    if(++hits[id] == need) candidates.push_back(id);
+                }
+            }
+            for(uint32_t g : grams) {
+                auto it = postings.find(g);
+                if(it == postings.end()) continue;
+                for(uint32_t id : it->second) hits[id] = 0;
+            }
+        } else {
+            int lo = max(0, (int)fq.size() - maxDist), hi = fq.size() + maxDist;
+            for(int len = lo; len <= hi && len < (int)byLength.size(); len++) {
+                candidates.insert(candidates.end(), byLength[len].begin(), byLength[len].end());
+            }
+        }
+        
+        vector<pair<int, uint32_t>> matches;  // (distance, name id)
+        for(uint32_t id : candidates) {
+            if(handles[id].empty()) continue;
+            int d = boundedDistance(fq, folded[id], maxDist);
+            if(d <= maxDist) matches.push_back({d, id});
+        }
+        sort(matches.begin(), matches.end(), [this](const pair<int, uint32_t>& x, const pair<int, uint32_t>& y) {
+            if(x.first != y.first) return x.first < y.first;
+            return folded[x.second] < folded[y.second];
+        });
+        vector<pair<int, int>> out;
+        for(auto& m : matches) {
+            for(int h : handles[m.second]) {
+                if(out.size() == limit) return out;
+                out.push_back({h, m.first});
+            }
+        }
+        return out;
+    }
+    
+    size_t distinctNames() const { return names.size(); }
+};
+
 // ==================== HASH TABLE FOR QUICK LOOKUP ====================
 
 class HashTable {
@@ -263,14 +443,447 @@ public:
     }
 };
 
+// ==================== THREAD POOL AND PARALLEL MERGE SORT ====================
+
+// ThreadPool, TaskGroup and the merge sort are copies of the ones in
+// labAssignment3.cpp, documented there, with insertion sort as the base case.
+class ThreadPool {
+private:
+    vector<thread> workers;
+    deque<function<void()>> tasks;
+    mutex lock;
+    condition_variable wake;
+    bool stopping;
+    
+    void workerLoop() {
+        while(true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> guard(lock);
+                wake.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if(tasks.empty()) return;
+                // workers take the oldest task, which is usually the largest
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+    
+public:
+    // threads counts the caller, so ThreadPool(4) starts 3 workers
+    explicit ThreadPool(unsigned threads) : stopping(false) {
+        for(unsigned i = 1; i < threads; i++) {
+            workers.push_back(thread(&ThreadPool::workerLoop, this));
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(size_t i = 0; i < workers.size(); i++) workers[i].join();
+    }
+    
+    unsigned threadCount() const { return workers.size() + 1; }
+    
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push_back(move(task));
+        }
+        wake.notify_one();
+    }
+    
+    // Run the newest queued task in the calling thread; false if none
+    bool runPending() {
+        function<void()> task;
+        {
+            lock_guard<mutex> guard(lock);
+            if(tasks.empty()) return false;
+            task = move(tasks.back());
+            tasks.pop_back();
+        }
+        task();
+        return true;
+    }
+};
+
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    atomic<int> pending;
+    
+public:
+    explicit TaskGroup(ThreadPool& p) : pool(p), pending(0) {}
+    ~TaskGroup() { wait(); }
+    
+    template <class F>
+    void run(F f) {
+        if(pool.threadCount() == 1) {
+            f();
+            return;
+        }
+        pending++;
+        pool.submit([this, f] {
+            f();
+            pending--;
+        });
+    }
+    
+    void wait() {
+        while(pending.load() > 0) {
+            if(!pool.runPending()) this_thread::yield();
+        }
+    }
+};
+
+// Pool shared by the parallel merge sort, one thread per hardware thread.
+// It is made on first use, so small interactive sorts never start any
+// threads.
+inline ThreadPool& sortPool() {
+    static ThreadPool pool(max(1u, thread::hardware_concurrency()));
+    return pool;
+}
+
+// Ranges up to PARALLEL_CUTOFF elements are sorted or merged by the calling
+// thread; larger ones are split into pool tasks. The sort is stable, so its
+// result does not depend on the number of threads.
+const size_t PARALLEL_CUTOFF = 1 << 14;
+
+// sortedOrder only goes parallel from this many students on
+const size_t PARALLEL_MIN_SIZE = 1 << 16;
+
+template <class T, class Less>
+void insertionSortRange(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    for(size_t i = lo + 1; i < hi; i++) {
+        T key = move(arr[i]);
+        size_t j = i;
+        while(j > lo && less(key, arr[j - 1])) {
+            arr[j] = move(arr[j - 1]);
+            j--;
+        }
+        arr[j] = move(key);
+    }
+}
+
+template <class T, class Less>
+void mergeRuns(T* a, size_t na, T* b, size_t nb, T* out, Less less) {
+    T* endA = a + na;
+    T* endB = b + nb;
+    while(a < endA && b < endB) {
+        if(less(*b, *a)) *out++ = move(*b++);
+        else *out++ = move(*a++);
+    }
+    out = move(a, endA, out);
+    move(b, endB, out);
+}
+
+template <class T, class Less>
+void parallelMerge(T* a, size_t na, T* b, size_t nb, T* out, Less less, ThreadPool& pool) {
+    if(na + nb <= PARALLEL_CUTOFF) {
+        mergeRuns(a, na, b, nb, out, less);
+        return;
+    }
+    size_t cutA, cutB;
+    if(na >= nb) {
+        cutA = na / 2;
+        cutB = lower_bound(b, b + nb, a[cutA], less) - b;
+    } else {
+        cutB = nb / 2;
+        cutA = upper_bound(a, a + na, b[cutB], less) - a;
+    }
+    TaskGroup group(pool);
+    group.run([=, &pool] { parallelMerge(a, cutA, b, cutB, out, less, pool); });
+    parallelMerge(a + cutA, na - cutA, b + cutB, nb - cutB, out + cutA + cutB, less, pool);
+    group.wait();
+}
+
+template <class T, class Less>
+void parallelMergeSortRange(vector<T>& arr, vector<T>& buf, size_t lo, size_t hi,
+                            bool toBuf, Less less, ThreadPool& pool) {
+    if(hi - lo <= 32) {
+        insertionSortRange(arr, lo, hi, less);
+        if(toBuf) move(arr.begin() + lo, arr.begin() + hi, buf.begin() + lo);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    if(hi - lo > PARALLEL_CUTOFF) {
+        TaskGroup group(pool);
+        group.run([&, lo, mid] { parallelMergeSortRange(arr, buf, lo, mid, !toBuf, less, pool); });
+        parallelMergeSortRange(arr, buf, mid, hi, !toBuf, less, pool);
+        group.wait();
+    } else {
+        parallelMergeSortRange(arr, buf, lo, mid, !toBuf, less, pool);
+        parallelMergeSortRange(arr, buf, mid, hi, !toBuf, less, pool);
+    }
+    T* src = toBuf ? arr.data() : buf.data();
+    T* dst = toBuf ? buf.data() : arr.data();
+    parallelMerge(src + lo, mid - lo, src + mid, hi - mid, dst + lo, less, pool);
+}
+
+template <class T, class Less>
+void parallelMergeSortBy(vector<T>& arr, Less less, ThreadPool& pool) {
+    if(arr.size() < 2) return;
+    vector<T> buf(arr.size());
+    parallelMergeSortRange(arr, buf, 0, arr.size(), false, less, pool);
+}
+
+// ==================== INTROSORT ====================
+
+// Copy of the introsort in labAssignment3.cpp, documented there, with
+// insertion sort as the base case.
+const size_t INSERTION_SORT_MAX = 24;
+const size_t NINTHER_MIN = 128;
+
+inline int floorLog2(size_t n) {
+    int log = 0;
+    while(n >>= 1) log++;
+    return log;
+}
+
+template <class T, class Less>
+void sortThree(vector<T>& arr, size_t a, size_t b, size_t c, Less less) {
+    if(less(arr[b], arr[a])) swap(arr[a], arr[b]);
+    if(less(arr[c], arr[b])) swap(arr[b], arr[c]);
+    if(less(arr[b], arr[a])) swap(arr[a], arr[b]);
+}
+
+template <class T, class Less>
+void siftDownRange(vector<T>& arr, size_t lo, size_t n, size_t i, Less less) {
+    T value = move(arr[lo + i]);
+    while(2 * i + 1 < n) {
+        size_t child = 2 * i + 1;
+        if(child + 1 < n && less(arr[lo + child], arr[lo + child + 1])) child++;
+        if(!less(value, arr[lo + child])) break;
+        arr[lo + i] = move(arr[lo + child]);
+        i = child;
+    }
+    arr[lo + i] = move(value);
+}
+
+template <class T, class Less>
+void heapSortRange(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    size_t n = hi - lo;
+    for(size_t i = n / 2; i-- > 0;) siftDownRange(arr, lo, n, i, less);
+    for(size_t end = n; end-- > 1;) {
+        swap(arr[lo], arr[lo + end]);
+        siftDownRange(arr, lo, end, 0, less);
+    }
+}
+
+template <class T, class Less>
+bool partialInsertionSort(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    size_t moves = 0;
+    for(size_t i = lo + 1; i < hi; i++) {
+        if(!less(arr[i], arr[i - 1])) continue;
+        T key = move(arr[i]);
+        size_t j = i;
+        do {
+            arr[j] = move(arr[j - 1]);
+            j--;
+        } while(j > lo && less(key, arr[j - 1]));
+        arr[j] = move(key);
+        moves += i - j;
+        if(moves > 8) return false;
+    }
+    return true;
+}
+
+template <class T, class Less>
+pair<size_t, bool> partitionRight(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    T pivot = arr[lo];
+    size_t first = lo, last = hi;
+    while(less(arr[++first], pivot)) {}
+    if(first - 1 == lo) {
+        while(first < last && !less(arr[--last], pivot)) {}
+    } else {
+        while(!less(arr[--last], pivot)) {}
+    }
+    bool noSwaps = first >= last;
+    while(first < last) {
+        swap(arr[first], arr[last]);
+        while(less(arr[++first], pivot)) {}
+        while(!less(arr[--last], pivot)) {}
+    }
+    size_t pivotPos = first - 1;
+    arr[lo] = move(arr[pivotPos]);
+    arr[pivotPos] = move(pivot);
+    return make_pair(pivotPos, noSwaps);
+}
+
+template <class T, class Less>
+size_t partitionLeft(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    T pivot = arr[lo];
+    size_t first = lo, last = hi;
+    while(less(pivot, arr[--last])) {}
+    if(last + 1 == hi) {
+        while(first < last && !less(pivot, arr[++first])) {}
+    } else {
+        while(!less(pivot, arr[++first])) {}
+    }
+    while(first < last) {
+        swap(arr[first], arr[last]);
+        while(less(pivot, arr[--last])) {}
+        while(!less(pivot, arr[++first])) {}
+    }
+    arr[lo] = move(arr[last]);
+    arr[last] = move(pivot);
+    return last;
+}
+
+template <class T, class Less>
+void introSortLoop(vector<T>& arr, size_t lo, size_t hi, int depthLimit, Less less, bool leftmost) {
+    while(true) {
+        size_t n = hi - lo;
+        if(n < INSERTION_SORT_MAX) {
+            insertionSortRange(arr, lo, hi, less);
+            return;
+        }
+        if(depthLimit == 0) {
+            heapSortRange(arr, lo, hi, less);
+            return;
+        }
+        depthLimit--;
+        
+        size_t mid = lo + n / 2;
+        if(n > NINTHER_MIN) {
+            sortThree(arr, lo, mid, hi - 1, less);
+            sortThree(arr, lo + 1, mid - 1, hi - 2, less);
+            sortThree(arr, lo + 2, mid + 1, hi - 3, less);
+            sortThree(arr, mid - 1, mid, mid + 1, less);
+            swap(arr[lo], arr[mid]);
+        } else {
+            sortThree(arr, mid, lo, hi - 1, less);
+        }
+        
+        // the element before the range is <= all of it; if it equals the
+        // pivot nothing here is smaller, so only split off the equal ones
+        if(!leftmost && !less(arr[lo - 1], arr[lo])) {
+            lo = partitionLeft(arr, lo, hi, less) + 1;
+            continue;
+        }
+        
+        pair<size_t, bool> split = partitionRight(arr, lo, hi, less);
+        size_t p = split.first;
+        if(split.second && partialInsertionSort(arr, lo, p, less)
+            && partialInsertionSort(arr, p + 1, hi, less)) {
+            return;
+        }
+        if(p - lo < hi - p) {
+            introSortLoop(arr, lo, p, depthLimit, less, leftmost);
+            lo = p + 1;
+            leftmost = false;
+        } else {
+            introSortLoop(arr, p + 1, hi, depthLimit, less, false);
+            hi = p;
+        }
+    }
+}
+
+template <class T, class Less>
+void introSortBy(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    if(hi - lo < 2) return;
+    introSortLoop(arr, lo, hi, 2 * floorLog2(hi - lo), less, true);
+}
+
+// ==================== NATURAL MERGE SORT ====================
+
+// Copy of naturalMergeSortBy in labAssignment3.cpp, documented there.
+const size_t MIN_RUN = 32;
+
+template <class T, class Less>
+void naturalMergeSortBy(vector<T>& arr, size_t lo, size_t hi, Less less) {
+    size_t n = hi - lo;
+    if(n < 2) return;
+    
+    // run k is [runs[k], runs[k + 1]), offsets from lo
+    vector<size_t> runs;
+    runs.reserve(n / MIN_RUN + 2);
+    runs.push_back(0);
+    T* data = &arr[lo];
+    size_t start = 0;
+    while(start < n) {
+        size_t end = start + 1;
+        if(end < n && less(data[end], data[start])) {
+            while(end + 1 < n && less(data[end + 1], data[end])) end++;
+            end++;
+            reverse(data + start, data + end);
+        } else {
+            while(end < n && !less(data[end], data[end - 1])) end++;
+        }
+        if(end - start < MIN_RUN) {
+            end = min(n, start + MIN_RUN);
+            insertionSortRange(arr, lo + start, lo + end, less);
+        }
+        runs.push_back(end);
+        start = end;
+    }
+    if(runs.size() == 2) return;
+    
+    vector<T> buffer(n);
+    T* src = data;
+    T* dst = buffer.data();
+    while(runs.size() > 2) {
+        size_t kept = 1;
+        for(size_t k = 0; k + 1 < runs.size(); k += 2) {
+            size_t a = runs[k], mid = runs[k + 1];
+            if(k + 2 < runs.size()) {
+                size_t b = runs[k + 2];
+                mergeRuns(src + a, mid - a, src + mid, b - mid, dst + a, less);
+                runs[kept++] = b;
+            } else {
+                move(src + a, src + mid, dst + a);
+                runs[kept++] = mid;
+            }
+        }
+        runs.resize(kept);
+        swap(src, dst);
+    }
+    if(src != data) move(src, src + n, data);
+}
+
+// Sort key for indirect sorting: the key an algorithm orders by plus the
+// student's position in the list. Names are referenced, not copied.
+template <class K>
+struct KeyIndex {
+    K key;
+    uint32_t index;
+};
+
+// Copy of floatOrderKey in labAssignment3.cpp, documented there.
+inline uint32_t floatOrderKey(float f) {
+    if(f == 0.0f) f = 0.0f;
+    uint32_t u;
+    memcpy(&u, &f, sizeof u);
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+// The sorts are templates over the element type and read their key through
+// the *Key() overloads, so the same code sorts Student records or KeyIndex
+// pairs. Sorting pairs moves 8-16 bytes per swap instead of a whole Student
+// with its strings, and gives exactly the same order, because the
+// algorithms only ever look at the key.
 class SortingAlgorithms {
 public:
+    static int rollKey(const Student& s) { return s.rollNumber; }
+    static int rollKey(const KeyIndex<int>& k) { return k.key; }
+    static float marksKey(const Student& s) { return s.totalMarks; }
+    static float marksKey(const KeyIndex<float>& k) { return k.key; }
+    static float percentageKey(const Student& s) { return s.percentage; }
+    static float percentageKey(const KeyIndex<float>& k) { return k.key; }
+    static const string& nameKey(const Student& s) { return s.name; }
+    static const string& nameKey(const KeyIndex<const string*>& k) { return *k.key; }
+    
     // Bubble Sort by Roll Number
-    static void bubbleSortByRoll(vector<Student>& students) {
+    template <class T>
+    static void bubbleSortByRoll(vector<T>& students) {
         int n = students.size();
         for(int i = 0; i < n-1; i++) {
             for(int j = 0; j < n-i-1; j++) {
-                if(students[j].rollNumber > students[j+1].rollNumber) {
+                if(rollKey(students[j]) > rollKey(students[j+1])) {
                     swap(students[j], students[j+1]);
                 }
             }
@@ -278,13 +891,14 @@ public:
     }
     
     // Insertion Sort by Marks
-    static void insertionSortByMarks(vector<Student>& students) {
+    template <class T>
+    static void insertionSortByMarks(vector<T>& students) {
         int n = students.size();
         for(int i = 1; i < n; i++) {
-            Student key = students[i];
+            T key = students[i];
             int j = i - 1;
             
-            while(j >= 0 && students[j].totalMarks < key.totalMarks) {
+            while(j >= 0 && marksKey(students[j]) < marksKey(key)) {
                 students[j+1] = students[j];
                 j--;
             }
@@ -292,89 +906,37 @@ public:
         }
     }
     
-    // Quick Sort by Percentage
-    static int partition(vector<Student>& students, int low, int high) {
-        float pivot = students[high].percentage;
-        int i = low - 1;
-        
-        for(int j = low; j < high; j++) {
-            if(students[j].percentage >= pivot) {
-                i++;
-                swap(students[i], students[j]);
-            }
-        }
-        swap(students[i+1], students[high]);
-        return i + 1;
-    }
-    
-    static void quickSortByPercentage(vector<Student>& students, int low, int high) {
+    // Quick Sort by Percentage (highest first), students[low..high]. An
+    // introsort (see introSortBy), so lists already in percentage order,
+    // in reverse, or with many equal percentages stay O(n log n).
+    template <class T>
+    static void quickSortByPercentage(vector<T>& students, int low, int high) {
         if(low < high) {
-            int pi = partition(students, low, high);
-            quickSortByPercentage(students, low, pi - 1);
-            quickSortByPercentage(students, pi + 1, high);
+            introSortBy(students, low, high + 1, [](const T& x, const T& y) { return percentageKey(x) > percentageKey(y); });
         }
     }
     
-    // Merge Sort by Name
-    static void merge(vector<Student>& students, int left, int mid, int right) {
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
-        
-        vector<Student> leftArr(n1), rightArr(n2);
-        
-        for(int i = 0; i < n1; i++) {
-            leftArr[i] = students[left + i];
-        }
-        for(int j = 0; j < n2; j++) {
-            rightArr[j] = students[mid + 1 + j];
-        }
-        
-        int i = 0, j = 0, k = left;
-        
-        while(i < n1 && j < n2) {
-            if(leftArr[i].name <= rightArr[j].name) {
-                students[k] = leftArr[i];
-                i++;
-            } else {
-                students[k] = rightArr[j];
-                j++;
-            }
-            k++;
-        }
-        
-        while(i < n1) {
-            students[k] = leftArr[i];
-            i++;
-            k++;
-        }
-        
-        while(j < n2) {
-            students[k] = rightArr[j];
-            j++;
-            k++;
-        }
-    }
-    
-    static void mergeSortByName(vector<Student>& students, int left, int right) {
+    // Merge Sort by Name, students[left..right]: natural bottom-up merge
+    // sort with one scratch buffer (see naturalMergeSortBy)
+    template <class T>
+    static void mergeSortByName(vector<T>& students, int left, int right) {
         if(left < right) {
-            int mid = left + (right - left) / 2;
-            mergeSortByName(students, left, mid);
-            mergeSortByName(students, mid + 1, right);
-            merge(students, left, mid, right);
+            naturalMergeSortBy(students, left, right + 1, [](const T& x, const T& y) { return nameKey(x) < nameKey(y); });
         }
     }
     
     // Heap Sort by Total Marks
-    static void heapify(vector<Student>& students, int n, int i) {
+    template <class T>
+    static void heapify(vector<T>& students, int n, int i) {
         int largest = i;
         int left = 2 * i + 1;
         int right = 2 * i + 2;
         
-        if(left < n && students[left].totalMarks > students[largest].totalMarks) {
+        if(left < n && marksKey(students[left]) > marksKey(students[largest])) {
             largest = left;
         }
         
-        if(right < n && students[right].totalMarks > students[largest].totalMarks) {
+        if(right < n && marksKey(students[right]) > marksKey(students[largest])) {
             largest = right;
         }
         
@@ -384,7 +946,8 @@ public:
         }
     }
     
-    static void heapSortByMarks(vector<Student>& students) {
+    template <class T>
+    static void heapSortByMarks(vector<T>& students) {
         int n = students.size();
         
         // Build heap
@@ -398,6 +961,167 @@ public:
             heapify(students, i, 0);
         }
     }
+    
+    // LSD Radix Sort by Percentage (highest first): three stable counting
+    // passes of 11, 11 and 10 bits over the complemented float key, so
+    // students with equal percentages keep their order in the list
+    template <class T>
+    static void radixSortByPercentage(vector<T>& students) {
+        const int BITS = 11, RADIX = 1 << BITS, PASSES = 3;
+        size_t n = students.size();
+        if(n < 2) return;
+        
+        vector<uint32_t> count(PASSES * RADIX, 0);
+        for(size_t i = 0; i < n; i++) {
+            uint32_t key = ~floatOrderKey(percentageKey(students[i]));
+            for(int p = 0; p < PASSES; p++) {
+                count[p * RADIX + ((key >> (p * BITS)) & (RADIX - 1))]++;
+            }
+        }
+        
+        uint32_t firstKey = ~floatOrderKey(percentageKey(students[0]));
+        vector<T> buffer(n);
+        vector<T>* from = &students;
+        vector<T>* to = &buffer;
+        for(int p = 0; p < PASSES; p++) {
+            int shift = p * BITS;
+            uint32_t* c = &count[p * RADIX];
+            if(c[(firstKey >> shift) & (RADIX - 1)] == n) continue;  // one digit only
+            
+            uint32_t sum = 0;
+            for(int d = 0; d < RADIX; d++) {
+                uint32_t here = c[d];
+                c[d] = sum;
+                sum += here;
+            }
+            for(size_t i = 0; i < n; i++) {
+                uint32_t d = (~floatOrderKey(percentageKey((*from)[i])) >> shift) & (RADIX - 1);
+                (*to)[c[d]++] = move((*from)[i]);
+            }
+            swap(from, to);
+        }
+        if(from != &students) students = move(*from);
+    }
+    
+    // Parallel Merge Sort by Name on pool; stable, so the result is
+    // exactly mergeSortByName's
+    template <class T>
+    static void parallelMergeSortByName(vector<T>& students, ThreadPool& pool) {
+        parallelMergeSortBy(students, [](const T& x, const T& y) { return nameKey(x) < nameKey(y); }, pool);
+    }
+    
+    // Large name sorts go to the shared pool when there is more than one
+    // hardware thread. Quick sort stays sequential: a parallel one would
+    // order equal percentages differently.
+    static bool useParallel(size_t n) {
+        return n >= PARALLEL_MIN_SIZE && sortPool().threadCount() > 1;
+    }
+    
+    template <class K, class Get>
+    static vector<KeyIndex<K>> makeKeys(const vector<Student>& students, Get get) {
+        vector<KeyIndex<K>> keys(students.size());
+        for(size_t i = 0; i < students.size(); i++) {
+            keys[i].key = get(students[i]);
+            keys[i].index = i;
+        }
+        return keys;
+    }
+    
+    template <class K>
+    static vector<uint32_t> indicesOf(const vector<KeyIndex<K>>& keys) {
+        vector<uint32_t> order(keys.size());
+        for(size_t i = 0; i < keys.size(); i++) order[i] = keys[i].index;
+        return order;
+    }
+    
+    // Indirect sort: order[i] is the position of the i-th student once
+    // sorted by display menu choice (1-6); the list itself is not touched
+    static vector<uint32_t> sortedOrder(const vector<Student>& students, int choice) {
+        switch(choice) {
+            case 1: {
+                vector<KeyIndex<int>> keys = makeKeys<int>(students, [](const Student& s) { return s.rollNumber; });
+                bubbleSortByRoll(keys);
+                return indicesOf(keys);
+            }
+            case 2: {
+                vector<KeyIndex<float>> keys = makeKeys<float>(students, [](const Student& s) { return s.totalMarks; });
+                insertionSortByMarks(keys);
+                return indicesOf(keys);
+            }
+            case 3: {
+                vector<KeyIndex<float>> keys = makeKeys<float>(students, [](const Student& s) { return s.percentage; });
+                quickSortByPercentage(keys, 0, (int)keys.size() - 1);
+                return indicesOf(keys);
+            }
+            case 4: {
+                vector<KeyIndex<const string*>> keys = makeKeys<const string*>(students, [](const Student& s) { return &s.name; });
+                if(useParallel(keys.size())) parallelMergeSortByName(keys, sortPool());
+                else mergeSortByName(keys, 0, (int)keys.size() - 1);
+                return indicesOf(keys);
+            }
+            case 5: {
+                vector<KeyIndex<float>> keys = makeKeys<float>(students, [](const Student& s) { return s.totalMarks; });
+                heapSortByMarks(keys);
+                return indicesOf(keys);
+            }
+            case 6: {
+                vector<KeyIndex<float>> keys = makeKeys<float>(students, [](const Student& s) { return s.percentage; });
+                radixSortByPercentage(keys);
+                return indicesOf(keys);
+            }
+        }
+        vector<uint32_t> order(students.size());
+        for(size_t i = 0; i < order.size(); i++) order[i] = i;
+        return order;
+    }
+    
+    // Positions of the k students with the highest percentage, best first
+    // (ties by position): a min-heap holds the best k seen so far, so this
+    // is O(n log k) instead of sorting the whole list
+    static vector<uint32_t> topByPercentage(const vector<Student>& students, size_t k) {
+        auto better = [](const KeyIndex<float>& a, const KeyIndex<float>& b) {
+            return a.key > b.key || (a.key == b.key && a.index < b.index);
+        };
+        // with "better" as the ordering the top of the heap is the weakest kept
+        priority_queue<KeyIndex<float>, vector<KeyIndex<float>>, decltype(better)> heap(better);
+        for(size_t i = 0; i < students.size(); i++) {
+            KeyIndex<float> cur = {students[i].percentage, (uint32_t)i};
+            if(heap.size() < k) {
+                heap.push(cur);
+            } else if(k > 0 && better(cur, heap.top())) {
+                heap.pop();
+                heap.push(cur);
+            }
+        }
+        vector<uint32_t> top(heap.size());
+        for(size_t i = top.size(); i-- > 0; ) {
+            top[i] = heap.top().index;
+            heap.pop();
+        }
+        return top;
+    }
+    
+    // Put students into the given order in place, following the cycles of
+    // the permutation, so each record is moved exactly once
+    static void applyOrder(vector<Student>& students, vector<uint32_t> order) {
+        for(size_t i = 0; i < students.size(); i++) {
+            if(order[i] == i) continue;
+            Student tmp = move(students[i]);
+            size_t j = i;
+            while(order[j] != i) {
+                size_t k = order[j];
+                students[j] = move(students[k]);
+                order[j] = j;
+                j = k;
+            }
+            students[j] = move(tmp);
+            order[j] = j;
+        }
+    }
+    
+    static void sortIndirect(vector<Student>& students, int choice) {
+        applyOrder(students, sortedOrder(students, choice));
+    }
 };
 
 // ==================== AVL TREE FOR BALANCED OPERATIONS ====================
@@ -546,11 +1270,197 @@ public:
     }
 };
 
+// ==================== ORDER-STATISTIC TREE FOR MERIT RANKS ====================
+// AVL tree of (percentage, roll number) in merit order: higher percentage
+// first, then lower roll number. Every node also counts the nodes in its
+// subtree, so a student's rank and the k-th best student are one O(log n)
+// walk from the root. A marks update is a remove and an insert.
+
+class RankNode {
+public:
+    float percentage;
+    int rollNumber;
+    RankNode* left;
+    RankNode* right;
+    int height;
+    int size;
+    
+    RankNode(float p, int roll) {
+        percentage = p;
+        rollNumber = roll;
+        left = nullptr;
+        right = nullptr;
+        height = 1;
+        size = 1;
+    }
+};
+
+class RankTree {
+private:
+    RankNode* root;
+    
+    int getHeight(RankNode* node) {
+        if(node == nullptr) return 0;
+        return node->height;
+    }
+    
+    int getSize(RankNode* node) {
+        if(node == nullptr) return 0;
+        return node->size;
+    }
+    
+    void update(RankNode* node) {
+        node->height = 1 + max(getHeight(node->left), getHeight(node->right));
+        node->size = 1 + getSize(node->left) + getSize(node->right);
+    }
+    
+    // (p, roll) comes before node in merit order
+    bool before(float p, int roll, RankNode* node) {
+        return p > node->percentage || (p == node->percentage && roll < node->rollNumber);
+    }
+    
+    RankNode* rotateRight(RankNode* y) {
+        RankNode* x = y->left;
+        y->left = x->right;
+        x->right = y;
+        update(y);
+        update(x);
+        return x;
+    }
+    
+    RankNode* rotateLeft(RankNode* x) {
+        RankNode* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        update(x);
+        update(y);
+        return y;
+    }
+    
+    RankNode* rebalance(RankNode* node) {
+        update(node);
+        int balance = getHeight(node->left) - getHeight(node->right);
+        if(balance > 1) {
+            if(getHeight(node->left->left) < getHeight(node->left->right)) {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if(balance < -1) {
+            if(getHeight(node->right->right) < getHeight(node->right->left)) {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+    
+    RankNode* insertHelper(RankNode* node, float p, int roll) {
+        if(node == nullptr) {
+            return new RankNode(p, roll);
+        }
+        if(before(p, roll, node)) {
+            node->left = insertHelper(node->left, p, roll);
+        } else if(p != node->percentage || roll != node->rollNumber) {
+            node->right = insertHelper(node->right, p, roll);
+        } else {
+            return node;  // already there
+        }
+        return rebalance(node);
+    }
+    
+    RankNode* removeHelper(RankNode* node, float p, int roll) {
+        if(node == nullptr) return nullptr;
+        
+        if(before(p, roll, node)) {
+            node->left = removeHelper(node->left, p, roll);
+        } else if(p != node->percentage || roll != node->rollNumber) {
+            node->right = removeHelper(node->right, p, roll);
+        } else {
+            if(node->left == nullptr || node->right == nullptr) {
+                RankNode* child = node->left != nullptr ? node->left : node->right;
+                delete node;
+                return child;
+            }
+            // take the place of the next student in merit order
+            RankNode* next = node->right;
+            while(next->left != nullptr) next = next->left;
+            node->percentage = next->percentage;
+            node->rollNumber = next->rollNumber;
+            node->right = removeHelper(node->right, next->percentage, next->rollNumber);
+        }
+        return rebalance(node);
+    }
+    
+    void destroy(RankNode* node) {
+        if(node != nullptr) {
+            destroy(node->left);
+            destroy(node->right);
+            delete node;
+        }
+    }
+    
+public:
+    RankTree() {
+        root = nullptr;
+    }
+    
+    ~RankTree() {
+        destroy(root);
+    }
+    
+    void insert(float p, int roll) {
+        root = insertHelper(root, p, roll);
+    }
+    
+    void remove(float p, int roll) {
+        root = removeHelper(root, p, roll);
+    }
+    
+    int size() {
+        return getSize(root);
+    }
+    
+    // 1 + students with a higher percentage, so equal percentages share a rank
+    int rankOf(float p) {
+        int above = 0;
+        RankNode* node = root;
+        while(node != nullptr) {
+            if(node->percentage > p) {
+                above += getSize(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return above + 1;
+    }
+    
+    // roll number of the k-th best student (k from 1), or -1
+    int kth(int k) {
+        RankNode* node = root;
+        while(node != nullptr) {
+            int leftSize = getSize(node->left);
+            if(k <= leftSize) {
+                node = node->left;
+            } else if(k == leftSize + 1) {
+                return node->rollNumber;
+            } else {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+        return -1;
+    }
+};
+
 class StudentResultManagementSystem {
 private:
     StudentBST bst;
     AVLTree avl;
     HashTable hashTable;
+    NameIndex nameIndex;
+    RankTree rankTree;
     vector<Student> studentList;
     
 public:
@@ -595,6 +1505,8 @@ public:
         bst.insert(newStudent);
         avl.insert(newStudent);
         hashTable.insert(newStudent);
+        nameIndex.add(newStudent.name, newStudent.rollNumber);
+        rankTree.insert(newStudent.percentage, newStudent.rollNumber);
         studentList.push_back(newStudent);
         
         cout << "Student added successfully!" << endl;
@@ -620,6 +1532,7 @@ public:
                  << double(end - start) / CLOCKS_PER_SEC * 1000 
                  << " ms):" << endl;
             result1->displayDetailed();
+            cout << "Merit Rank: " << rankTree.rankOf(result1->percentage) << " of " << rankTree.size() << endl;
         }
         
         // Search in AVL Tree (O(log n))
@@ -649,6 +1562,51 @@ public:
         }
     }
     
+    // Search student by name: exact, then prefix, then up to 2 typos
+    void searchByName() {
+        string query;
+        cout << "\n--- Search by Name ---" << endl;
+        cout << "Enter name, prefix or misspelled name: ";
+        cin.ignore();
+        getline(cin, query);
+        
+        vector<int> shown = nameIndex.exact(query);
+        auto isNew = [&shown](int roll) {
+            if(find(shown.begin(), shown.end(), roll) != shown.end()) return false;
+            shown.push_back(roll);
+            return true;
+        };
+        vector<int> starts;
+        for(int roll : nameIndex.prefix(query, 20)) {
+            if(isNew(roll)) starts.push_back(roll);
+        }
+        vector<pair<int, int>> close;
+        for(auto& c : nameIndex.fuzzy(query, 2, 10)) {
+            if(isNew(c.first)) close.push_back(c);
+        }
+        
+        if(shown.empty()) {
+            cout << "Student not found!" << endl;
+            return;
+        }
+        size_t exactCount = shown.size() - starts.size() - close.size();
+        if(exactCount > 0) {
+            cout << "\nExact matches:" << endl;
+            for(size_t i = 0; i < exactCount; i++) hashTable.search(shown[i])->display();
+        }
+        if(!starts.empty()) {
+            cout << "\nNames starting with \"" << query << "\":" << endl;
+            for(int roll : starts) hashTable.search(roll)->display();
+        }
+        if(!close.empty()) {
+            cout << "\nClose matches (up to 2 typos):" << endl;
+            for(auto& c : close) {
+                cout << "[" << c.second << "] ";
+                hashTable.search(c.first)->display();
+            }
+        }
+    }
+    
     // Update student marks
     void updateStudentMarks() {
         int roll;
@@ -662,6 +1620,7 @@ public:
             return;
         }
         
+        float oldPercentage = student->percentage;
         cout << "Current marks:" << endl;
         string subjects[5] = {"Math", "Science", "English", "History", "Computer"};
         for(int i = 0; i < 5; i++) {
@@ -684,6 +1643,16 @@ public:
         }
         
         student->calculateResult();
+        rankTree.remove(oldPercentage, roll);
+        rankTree.insert(student->percentage, roll);
+        
+        // keep the list used for display, merit list and statistics in step
+        for(size_t i = 0; i < studentList.size(); i++) {
+            if(studentList[i].rollNumber == roll) {
+                studentList[i] = *student;
+                break;
+            }
+        }
         cout << "\nMarks updated successfully!" << endl;
         student->displayDetailed();
     }
@@ -701,36 +1670,36 @@ public:
         cout << "3. Sort by Percentage (Quick Sort)" << endl;
         cout << "4. Sort by Name (Merge Sort)" << endl;
         cout << "5. Sort by Total Marks (Heap Sort)" << endl;
-        cout << "6. No Sorting" << endl;
+        cout << "6. Sort by Percentage (Radix Sort)" << endl;
+        cout << "7. No Sorting" << endl;
         cout << "Enter choice: ";
         
         int choice;
         cin >> choice;
         
-        vector<Student> displayList = studentList;
+        // indirect: the algorithms sort (key, position) pairs, the list stays put
+        vector<uint32_t> order = SortingAlgorithms::sortedOrder(studentList, choice);
         
         switch(choice) {
             case 1:
-                SortingAlgorithms::bubbleSortByRoll(displayList);
                 cout << "\n--- Students Sorted by Roll Number ---" << endl;
                 break;
             case 2:
-                SortingAlgorithms::insertionSortByMarks(displayList);
                 cout << "\n--- Students Sorted by Total Marks (Highest First) ---" << endl;
                 break;
             case 3:
-                SortingAlgorithms::quickSortByPercentage(displayList, 0, displayList.size()-1);
                 cout << "\n--- Students Sorted by Percentage (Highest First) ---" << endl;
                 break;
             case 4:
-                SortingAlgorithms::mergeSortByName(displayList, 0, displayList.size()-1);
                 cout << "\n--- Students Sorted by Name ---" << endl;
                 break;
             case 5:
-                SortingAlgorithms::heapSortByMarks(displayList);
                 cout << "\n--- Students Sorted by Total Marks (Heap Sort) ---" << endl;
                 break;
             case 6:
+                cout << "\n--- Students Sorted by Percentage (Radix Sort) ---" << endl;
+                break;
+            case 7:
                 cout << "\n--- All Students (Unsorted) ---" << endl;
                 break;
             default:
@@ -739,11 +1708,11 @@ public:
         }
         
         cout << string(100, '-') << endl;
-        for(int i = 0; i < displayList.size(); i++) {
-            displayList[i].display();
+        for(size_t i = 0; i < order.size(); i++) {
+            studentList[order[i]].display();
         }
         cout << string(100, '-') << endl;
-        cout << "Total Students: " << displayList.size() << endl;
+        cout << "Total Students: " << order.size() << endl;
     }
     
     // Generate result statistics
@@ -798,6 +1767,12 @@ public:
         if(lowest) cout << lowest->name;
         cout << ")" << endl;
         
+        // middle of the merit order, an O(log n) query on the rank tree
+        Student* middle = hashTable.search(rankTree.kth((studentList.size() + 1) / 2));
+        if(middle) {
+            cout << "Median Percentage: " << middle->percentage << "% (" << middle->name << ")" << endl;
+        }
+        
         cout << "\nGrade Distribution:" << endl;
         string grades[7] = {"A+", "A", "B+", "B", "C", "D", "F"};
         for(int i = 0; i < 7; i++) {
@@ -825,20 +1800,21 @@ public:
             return;
         }
         
-        vector<Student> meritList = studentList;
-        SortingAlgorithms::quickSortByPercentage(meritList, 0, meritList.size()-1);
+        // only the top 10 are selected, ranks come from the rank tree
+        vector<uint32_t> order = SortingAlgorithms::topByPercentage(studentList, 10);
         
         cout << "\n==================== MERIT LIST ====================" << endl;
         cout << "Rank | Roll No | Name                 | Total | Percentage | Grade" << endl;
         cout << string(70, '-') << endl;
         
-        for(int i = 0; i < min(10, (int)meritList.size()); i++) {
-            cout << setw(4) << (i+1) << " | "
-                 << setw(7) << meritList[i].rollNumber << " | "
-                 << setw(20) << left << meritList[i].name << " | "
-                 << setw(5) << right << meritList[i].totalMarks << " | "
-                 << setw(9) << fixed << setprecision(2) << meritList[i].percentage << "% | "
-                 << meritList[i].grade << endl;
+        for(size_t i = 0; i < order.size(); i++) {
+            const Student& st = studentList[order[i]];
+            cout << setw(4) << rankTree.rankOf(st.percentage) << " | "
+                 << setw(7) << st.rollNumber << " | "
+                 << setw(20) << left << st.name << " | "
+                 << setw(5) << right << st.totalMarks << " | "
+                 << setw(9) << fixed << setprecision(2) << st.percentage << "% | "
+                 << st.grade << endl;
         }
         cout << string(70, '-') << endl;
     }
@@ -862,6 +1838,8 @@ public:
         
         if(confirm == 'y' || confirm == 'Y') {
             // Remove from all data structures
+            nameIndex.remove(student->name, roll);
+            rankTree.remove(student->percentage, roll);
             bst.deleteStudent(roll);
             hashTable.remove(roll);
             
@@ -932,15 +1910,21 @@ public:
         s8.calculateResult();
         samples.push_back(s8);
         
-        // Add all samples to data structures
+        // Add the samples whose roll number is not taken yet, so loading
+        // them twice does not duplicate the list or the indexes
+        int added = 0;
         for(int i = 0; i < samples.size(); i++) {
+            if(hashTable.search(samples[i].rollNumber) != nullptr) continue;
             bst.insert(samples[i]);
             avl.insert(samples[i]);
             hashTable.insert(samples[i]);
+            nameIndex.add(samples[i].name, samples[i].rollNumber);
+            rankTree.insert(samples[i].percentage, samples[i].rollNumber);
             studentList.push_back(samples[i]);
+            added++;
         }
         
-        cout << "Sample data added successfully! " << samples.size() << " students added." << endl;
+        cout << "Sample data added successfully! " << added << " students added." << endl;
     }
     
     // Compare search performance
@@ -1012,7 +1996,8 @@ int main() {
         cout << "7.  Generate Statistics" << endl;
         cout << "8.  Compare Search Performance" << endl;
         cout << "9.  Add Sample Data (Testing)" << endl;
-        cout << "10. Exit" << endl;
+        cout << "10. Search by Name" << endl;
+        cout << "11. Exit" << endl;
         cout << "Enter your choice: ";
         cin >> choice;
         
@@ -1045,6 +2030,9 @@ int main() {
                 system.addSampleData();
                 break;
             case 10:
+                system.searchByName();
+                break;
+            case 11:
                 cout << "\nThank you for using Student Result Management System!" << endl;
                 cout << "Goodbye!" << endl;
                 return 0;